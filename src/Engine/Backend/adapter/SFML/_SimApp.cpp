@@ -74,6 +74,7 @@ SimApp::SimApp(int argc, char** argv, View::ScreenView& main_view)
 	  ) // cfg()
 	// Bootstrap the backend...
 	, backend(SFML_Backend::use(cfg))
+	, jobs(cfg.worker_threads)
 	// Init the GUI...
 	, gui(((SFML_Backend&)backend).SFML_window(),
 	      {
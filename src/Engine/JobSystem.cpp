@@ -0,0 +1,234 @@
+// Must do this first for Tracy's winsock2.h has to precede any windows.h! :-/
+#include "extern/Tracy/public/tracy/Tracy.hpp"
+
+#include "JobSystem.hpp"
+
+#include <algorithm> // min, max
+#include <cassert>
+
+namespace Szim {
+
+using namespace std;
+
+namespace {
+	thread_local const JobSystem* t_pool = nullptr; // The pool of the current worker thread, if any
+	thread_local unsigned t_worker = 0;
+}
+
+//----------------------------------------------------------------------------
+JobSystem::Task* JobSystem::Graph::add(const char* name, Job job, initializer_list<Task*> deps)
+{
+	auto& t = _tasks.emplace_back();
+	t.name = name;
+	t.job = std::move(job);
+	for (auto d : deps) {
+		assert(d);
+		d->dependents.push_back(&t);
+		++t.unfinished_deps;
+	}
+	return &t;
+}
+
+
+//============================================================================
+JobSystem::JobSystem(unsigned workers)
+{
+#ifndef DISABLE_THREADS
+	if (!workers) workers = max(1u, thread::hardware_concurrency());
+	_worker_count = workers;
+	for (unsigned i = 0; i < workers; ++i)
+		_queues.push_back(make_unique<Queue>());
+	//! The threads are only started when needed; see _start_workers().
+#else
+	(void)workers;
+#endif
+}
+
+JobSystem::~JobSystem()
+{
+	wait_idle();
+	{ lock_guard lock(_sleep_mutex); _quit = true; }
+	_work_available.notify_all();
+	for (auto& t : _workers) t.join();
+}
+
+//----------------------------------------------------------------------------
+unsigned JobSystem::this_worker() const
+{
+	return t_pool == this ? t_worker : worker_count();
+}
+
+//----------------------------------------------------------------------------
+void JobSystem::_start_workers()
+{
+	call_once(_workers_started, [this] {
+		for (unsigned i = 0; i < _worker_count; ++i)
+			_workers.emplace_back(&JobSystem::_worker_main, this, i);
+	});
+}
+
+//----------------------------------------------------------------------------
+void JobSystem::_worker_main(unsigned id)
+{
+	t_pool = this;
+	t_worker = id;
+	for (;;) {
+		if (auto task = _grab(id)) {
+			_execute(task);
+			continue;
+		}
+		unique_lock lock(_sleep_mutex);
+		_work_available.wait(lock, [this] { return _quit || _queued > 0; });
+		if (_quit && !_queued) return;
+	}
+}
+
+//----------------------------------------------------------------------------
+void JobSystem::_push(Task* task)
+{
+	if (!_worker_count) { // Inline mode
+		_execute(task);
+		return;
+	}
+	_start_workers();
+
+	auto q = t_pool == this ? t_worker : _next_queue++ % worker_count();
+	{
+		lock_guard lock(_queues[q]->mutex);
+		_queues[q]->tasks.push_back(task);
+	}
+	++_queued;
+	{ lock_guard lock(_sleep_mutex); } //! Don't let the notification slip in between a worker's check & wait!
+	_work_available.notify_one();
+}
+
+//----------------------------------------------------------------------------
+JobSystem::Task* JobSystem::_grab(unsigned worker)
+{
+	auto n = worker_count();
+	for (unsigned i = 0; i < n; ++i) {
+		auto& q = *_queues[(worker + i) % n];
+		lock_guard lock(q.mutex);
+		if (q.tasks.empty()) continue;
+		Task* task;
+		if (i == 0) { task = q.tasks.back();  q.tasks.pop_back(); }  // Own: the newest (still hot in the cache)
+		else        { task = q.tasks.front(); q.tasks.pop_front(); } // Stolen: the oldest (likely the biggest)
+		--_queued;
+		return task;
+	}
+	return nullptr;
+}
+
+//----------------------------------------------------------------------------
+void JobSystem::_execute(Task* task)
+{
+	{
+		ZoneTransientN(___tracy_task_zone, task->name, true);
+		task->job();
+	}
+
+	for (auto d : task->dependents)
+		if (--d->unfinished_deps == 0) _push(d);
+
+	//! The task (and its whole batch) may be gone right after this:
+	if (--*task->pending == 0) {
+		{ lock_guard lock(_done_mutex); }
+		_batch_done.notify_all();
+		{ lock_guard lock(_sleep_mutex); }
+		_work_available.notify_all(); // For the workers waiting in _wait()
+	}
+}
+
+//----------------------------------------------------------------------------
+void JobSystem::_wait(atomic<size_t>& pending)
+{
+	if (t_pool == this) { // A worker: help out meanwhile (also to avoid deadlocks with nested jobs)
+		while (pending) {
+			if (auto task = _grab(t_worker)) {
+				_execute(task);
+				continue;
+			}
+			// Nothing to help with: sleep until there is, or the batch is done:
+			unique_lock lock(_sleep_mutex);
+			_work_available.wait(lock, [&] { return pending == 0 || _queued > 0; });
+		}
+	} else {
+		unique_lock lock(_done_mutex);
+		_batch_done.wait(lock, [&] { return pending == 0; });
+	}
+}
+
+
+//============================================================================
+void JobSystem::run(Graph& graph)
+{
+ZoneScoped;
+	if (graph._tasks.empty()) return;
+
+	atomic<size_t> pending = graph._tasks.size();
+	vector<Task*> roots;
+	for (auto& t : graph._tasks) {
+		t.pending = &pending;
+		if (!t.unfinished_deps) roots.push_back(&t); //! Collecting first, as the tasks can start changing right away!
+	}
+	assert(!roots.empty()); // Cycles could only be made by hacking the tasks directly...
+	for (auto t : roots) _push(t);
+
+	_wait(pending);
+}
+
+//----------------------------------------------------------------------------
+void JobSystem::parallel_for(const char* name, size_t count, size_t grain,
+                             const function<void(size_t first, size_t last)>& body,
+                             unsigned max_parallelism)
+{
+ZoneScoped;
+	if (!count) return;
+	grain = max(grain, size_t(1));
+	const size_t chunks = (count + grain - 1) / grain;
+
+	// Not a task per chunk, but one "runner" per worker (at most), each
+	// grabbing the next chunk, while there's any left:
+	size_t runners = max(1u, worker_count());
+	if (max_parallelism) runners = min(runners, size_t(max_parallelism));
+	runners = min(runners, chunks);
+
+	if (runners == 1) { // No point bothering the workers
+		for (size_t c = 0; c < chunks; ++c)
+			body(c * grain, min(count, (c + 1) * grain));
+		return;
+	}
+
+	atomic<size_t> next_chunk = 0;
+	Graph g;
+	for (size_t r = 0; r < runners; ++r) {
+		g.add(name, [&] {
+			for (size_t c; (c = next_chunk++) < chunks;)
+				body(c * grain, min(count, (c + 1) * grain));
+		});
+	}
+	run(g);
+}
+
+//----------------------------------------------------------------------------
+void JobSystem::submit(const char* name, Job job)
+{
+	Task* task;
+	{
+		lock_guard lock(_detached_mutex);
+		if (!_detached_pending) _detached.clear(); // All finished, so it's safe to recycle
+		task = &_detached.emplace_back();
+		task->name = name;
+		task->job = std::move(job);
+		task->pending = &_detached_pending;
+		++_detached_pending;
+	}
+	_push(task);
+}
+
+void JobSystem::wait_idle()
+{
+	_wait(_detached_pending);
+}
+
+} // namespace Szim
@@ -0,0 +1,133 @@
+#ifndef _JS4W9QX2M7TB0RZ5KN83VC6HY1DL0FE6_
+#define _JS4W9QX2M7TB0RZ5KN83VC6HY1DL0FE6_
+
+//============================================================================
+// Work-stealing task scheduler
+//
+// Every worker thread has its own task queue: new tasks submitted from a
+// worker go to its own queue (LIFO for the owner), and idle workers steal
+// from the other end of the others' queues. Tasks submitted from outside
+// (e.g. the update or the main thread) are dealt out to the queues in turn.
+//
+// Non-worker threads never run tasks (except for the inline cases below), they
+// just block while waiting, so the workers can be told apart by this_worker()
+// (e.g. for per-thread buffers).
+// Workers waiting for (nested) jobs do keep running other tasks meanwhile
+// (and block, too, if there's none).
+//
+// The worker threads are only started when the first task is queued, and a
+// parallel_for() that would only have one runner anyway just runs inline, so
+// nothing is started at all, if nothing is ever actually run in parallel.
+//
+// With DISABLE_THREADS (or 0 workers) everything just runs inline, in the
+// calling thread.
+//
+// Every task gets a (transient) Tracy zone with its name.
+//============================================================================
+
+#include <functional>
+#include <initializer_list>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <cstddef> // size_t
+
+namespace Szim {
+
+class JobSystem
+{
+public:
+	using Job = std::function<void()>;
+
+	//------------------------------------------------------------------------
+	struct Task
+	{
+		const char* name; //! Not copied: should be a literal (or live long enough)!
+		Job job;
+		std::atomic<unsigned> unfinished_deps = 0;
+		std::vector<Task*> dependents;
+		std::atomic<size_t>* pending = nullptr; // Countdown of the batch the task belongs to
+	};
+
+	//------------------------------------------------------------------------
+	// A DAG of tasks, to be run in one go (see run()). A task only starts after
+	// all of its dependencies (added earlier) have finished.
+	class Graph
+	{
+	public:
+		Task* add(const char* name, Job job, std::initializer_list<Task*> deps = {});
+		size_t size() const { return _tasks.size(); }
+		void clear() { _tasks.clear(); }
+	protected:
+		friend class JobSystem;
+		std::deque<Task> _tasks; //! deque, for stable addresses
+	};
+
+	//------------------------------------------------------------------------
+	explicit JobSystem(unsigned workers = 0); // 0: one per CPU core
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+
+	unsigned worker_count() const { return _worker_count; }
+
+	// The index of the current worker in [0, worker_count()), or worker_count()
+	// for any other thread (which is only running tasks in the inline mode, or
+	// single-runner parallel_for()s):
+	unsigned this_worker() const;
+
+	// Run all the tasks of the graph, and wait for them to finish:
+	void run(Graph& graph);
+
+	// Call body(first, last) for consecutive ranges of [0, count), with `grain`
+	// items (or less, for the last one) each, on at most `max_parallelism` (0:
+	// all) workers at once; returns when all done. (With only one chunk, or
+	// max_parallelism == 1, it's all done right in the calling thread.)
+	void parallel_for(const char* name, size_t count, size_t grain,
+	                  const std::function<void(size_t first, size_t last)>& body,
+	                  unsigned max_parallelism = 0);
+
+	// Fire & forget (e.g. background I/O); see also wait_idle():
+	void submit(const char* name, Job job);
+	void wait_idle(); // Wait for every submit()-ed task to finish
+
+protected:
+	struct Queue
+	{
+		std::mutex mutex;
+		std::deque<Task*> tasks;
+	};
+
+	void _start_workers(); // Once, at the first _push()
+	void _worker_main(unsigned id);
+	void _push(Task* task);
+	Task* _grab(unsigned worker); // Own queue first, then steal
+	void _execute(Task* task);
+	void _wait(std::atomic<size_t>& pending);
+
+	unsigned _worker_count = 0; //! Set before starting the workers (who also need it)
+	std::vector<std::thread> _workers;
+	std::once_flag _workers_started;
+	std::vector<std::unique_ptr<Queue>> _queues;
+	std::atomic<unsigned> _next_queue = 0; // For dealing out the outside submissions
+	std::atomic<size_t> _queued = 0;       // Total tasks waiting in the queues
+
+	std::mutex _sleep_mutex;
+	std::condition_variable _work_available;
+	std::mutex _done_mutex;
+	std::condition_variable _batch_done;
+	bool _quit = false;
+
+	// For submit():
+	std::mutex _detached_mutex;
+	std::deque<Task> _detached; // Recycled by submit() whenever all of them have finished
+	std::atomic<size_t> _detached_pending = 0;
+};
+
+} // namespace Szim
+
+#endif // _JS4W9QX2M7TB0RZ5KN83VC6HY1DL0FE6_
@@ -6,6 +6,7 @@
 //	using sz::to_bool
 
 #include <string>
+#include <algorithm> // max
 	using std::string, std::to_string;
 //	using std::stoul, std::stof;
 //	using namespace std::string_literals;
@@ -236,7 +237,7 @@ bool SimApp::toggle_fixed_model_dt()
       Model::World& SimApp::world()       { return _world; }
 const Model::World& SimApp::world() const { return _world; }
 const Model::World& SimApp::const_world() { return _world; }
-void SimApp::set_world(Model::World const& w) { _world = w; }
+void SimApp::set_world(Model::World const& w) { _world.assign_state(w); } //! Keep the cfg/cmdline processing options!
 
 
 //----------------------------------------------------------------------------
@@ -250,11 +251,31 @@ size_t SimApp::add_entity(const Entity& src)
 	return world().add_body(src);
 }
 
+size_t SimApp::add_entities(std::span<const Entity> src)
+{
+	return world().add_bodies(src);
+}
+
 void SimApp::remove_entity(size_t ndx)
 {
 	world().remove_body(ndx);
 }
 
+size_t SimApp::remove_terminated_entities(std::vector<size_t>* removed)
+{
+	return world().remove_terminated_bodies(removed);
+}
+
+void SimApp::reorder_entities(std::vector<size_t>* order)
+{
+	//! The players' entities stay in place, as their indexes are stored (see Player):
+	size_t first = 0;
+	for (const auto& p : players) {
+		if (p.entity_ndx < entity_count()) first = std::max(first, p.entity_ndx + 1);
+	}
+	world().reorder_bodies(first, order);
+}
+
 
 //----------------------------------------------------------------------------
 bool SimApp::quick_save_snapshot(unsigned slot_id) // starting from 1, not 0!
@@ -349,22 +370,22 @@ bool SimApp::entity_at_viewpos(float x, float y, size_t* entity_id OUT) const //
 
 
 //----------------------------------------------------------------------------
-void SimApp::undirected_interaction_hook(Model::World* w, Entity* obj1, Entity* obj2, float dt, double distance, ...)
+void SimApp::undirected_interaction_hook(Model::World* w, EntityRef obj1, EntityRef obj2, float dt, double distance, ...)
 {w, obj1, obj2, dt, distance;
 }
 
-void SimApp::directed_interaction_hook(Model::World* w, Entity* source, Entity* target, float dt, double distance, ...)
+void SimApp::directed_interaction_hook(Model::World* w, EntityRef source, EntityRef target, float dt, double distance, ...)
 {w, source, target, dt, distance;
 }
 
-bool SimApp::collide_hook(Model::World* w, Entity* obj1, Entity* obj2, double distance)
+bool SimApp::collide_hook(Model::World* w, EntityRef obj1, EntityRef obj2, double distance)
 {w, obj1, obj2, distance;
 	//!!?? body->interact(other_body) and then also, per Newton, other_body->interact(body)?!
 	//!!...body->p -= ds...;
 	return false;
 }
 
-bool SimApp::touch_hook(Model::World* w, Entity* obj1, Entity* obj2)
+bool SimApp::touch_hook(Model::World* w, EntityRef obj1, EntityRef obj2)
 {w, obj1, obj2;
 	return false;
 }
@@ -9,6 +9,7 @@
 #include "Time.hpp"
 #include "Avatar.hpp" // Fw-decl. is not enough for vector<Avatar>: namespace Szim { class Avatar; }
 #include "Player.hpp" // Fw-decl. is not enough for vector<Player>: namespace Szim { class Player; }
+#include "JobSystem.hpp"
 
 //!!... The UI and IO etc. are gonna be tough to abstract...
 //!!namespace sfw { class GUI; }
@@ -120,19 +121,22 @@ public:
 	}
 
 	// Entities...
-	using Entity = Model::World::Body;
+	using Entity = Model::World::Body;       // The "record" type (e.g. for adding new ones)
+	using EntityRef = Model::World::BodyRef; // Proxy to an entity in the (SoA) store of the world
 
 	size_t entity_count() const { return world().bodies.size(); }
 //!! ADD DEBUG-MODE BOUNDS-CHECKING FOR THESE!
+	//! NOTE: The EntityRef proxies get invalidated by adding/removing entities!
+	//!       The const versions return copies instead.
 	// Thread-safe, slower access:
-	      Entity& entity(size_t index)       { return *world().bodies[index]; }
-	const Entity& entity(size_t index) const { return *world().bodies[index]; }
-	const Entity& const_entity(size_t index) { return *world().bodies[index]; }
+	EntityRef entity(size_t index)             { return world().bodies[index]; }
+	Entity    entity(size_t index) const       { return world().bodies.get(index); }
+	Entity    const_entity(size_t index) const { return world().bodies.get(index); }
 	//!! This might be misguided, but keeping it as a reminder...
 	// Unprotected, faster access (when already locked):
-	      Entity& _entity(size_t index)       { return *_world.bodies[index]; }
-	const Entity& _entity(size_t index) const { return *_world.bodies[index]; }
-	const Entity& _const_entity(size_t index) { return *_world.bodies[index]; }
+	EntityRef _entity(size_t index)             { return _world.bodies[index]; }
+	Entity    _entity(size_t index) const       { return _world.bodies.get(index); }
+	Entity    _const_entity(size_t index) const { return _world.bodies.get(index); }
 
 //!!	bool entity_at(model::Math::Vector2f world_pos, size_t* entity_id OUT) const;
 //!!	bool entity_at(model::Math::Vector3f world_pos, size_t* entity_id OUT) const;
@@ -142,7 +146,12 @@ public:
 
 	virtual size_t add_entity(Entity&& temp);     // Move from temporary/template obj.
 	virtual size_t add_entity(const Entity& src); // Copy from obj.
+	virtual size_t add_entities(std::span<const Entity> src); // Copy in one go; returns the index of the first
 	virtual void remove_entity(size_t ndx);
+	// Remove all the terminated ones in one go (see World::remove_terminated_bodies()):
+	virtual size_t remove_terminated_entities(std::vector<size_t>* removed = nullptr);
+	// Sort them for locality, except the players' (see World::reorder_bodies()):
+	virtual void reorder_entities(std::vector<size_t>* order = nullptr);
 
 /*!!
 	using EntityTransform = void(*)(Entity&);
@@ -172,8 +181,8 @@ public:
 		assert(ndx < entity_count());
 		return ndx;
 	}
-	       Entity& player_entity(unsigned p = 1)       { assert(entity_count() > player_entity_ndx(p)); return entity(player_entity_ndx(p)); }
-	 const Entity& player_entity(unsigned p = 1) const { assert(entity_count() > player_entity_ndx(p)); return entity(player_entity_ndx(p)); }
+	EntityRef player_entity(unsigned p = 1)       { assert(entity_count() > player_entity_ndx(p)); return entity(player_entity_ndx(p)); }
+	Entity    player_entity(unsigned p = 1) const { assert(entity_count() > player_entity_ndx(p)); return entity(player_entity_ndx(p)); }
 
 	float player_idle_time(  unsigned player_id = 1) const; // No input for so many seconds (0: busy; gated by cfg.player_idle_threshold)
 	bool  player_idle(       unsigned player_id = 1) const { return player_idle_time(player_id) > 0; }
@@ -189,14 +198,15 @@ public:
 		return false;
 	}
 	*/
-	virtual bool collide_hook(Model::World* w, Entity* obj1, Entity* obj2, double distance);
-	virtual bool touch_hook(Model::World* w, Entity* obj1, Entity* obj2);
+	//! NOTE: These are called from inside the interaction loops, so they must not add/remove entities!
+	virtual bool collide_hook(Model::World* w, EntityRef obj1, EntityRef obj2, double distance);
+	virtual bool touch_hook(Model::World* w, EntityRef obj1, EntityRef obj2);
 
 	// High-level, abstract (not as in "generic", but "app-level") hook for n-body interactions:
 	// `event` represents the physical property/condition that made it think these might interact.
 	//!!NOTE: This will change to the objects themselves being notified (not the game "superclass")!
-	virtual void undirected_interaction_hook(Model::World* w, Entity* obj1, Entity* obj2, float dt, double distance, ...);
-	virtual void directed_interaction_hook(Model::World* w, Entity* source, Entity* target, float dt, double distance, ...);
+	virtual void undirected_interaction_hook(Model::World* w, EntityRef obj1, EntityRef obj2, float dt, double distance, ...);
+	virtual void directed_interaction_hook(Model::World* w, EntityRef source, EntityRef target, float dt, double distance, ...);
 
 
 	//----------------------------------------------------------------------------
@@ -218,9 +228,6 @@ protected:
 	//--------------------
 	// Rendering... (See also main_view()!)
 	virtual void draw() = 0;
-	//!! Render sync. kludge (used e.g. by the general-purpose particle emitter) -> #516...):
-		public: virtual void resize_shape(size_t /*ndx*/, float /*factor*/) {}
-		public: virtual void resize_shapes(float /*factor*/) {}
 
 //----------------------------------------------------------------------------
 // C++ mechanics...
@@ -240,6 +247,7 @@ protected:
 public: // E.g. the renderer still needs these...
 	SimAppConfig cfg;
 	Backend& backend;
+	JobSystem jobs; // For any parallel work (model updates, I/O etc.)
 
 	//--------------------------------------------------------------------
 	// Engine-specific UI that the client app is also free to use
@@ -91,6 +91,7 @@ SimAppConfig::SimAppConfig(const std::string& cfg_path, const Args& args, std::s
 	fps_limit        = get("sim/timing/fps_limit", DEFAULT_FPS_LIMIT);
 
 	global_interactions = get("sim/global_interactions", true);
+	worker_threads   = get("sim/worker_threads", 0u);
 
 	player_idle_threshold = DEFAULT_PLAYER_IDLE_THRESHOLD; //!! Make it adjustable!
 
@@ -137,6 +138,9 @@ SimAppConfig::SimAppConfig(const std::string& cfg_path, const Args& args, std::s
 	} if (args["fps_limit"]) { //!! Sigh, the dup...
 		try { fps_limit = stoul(args("fps_limit")); } catch(...) {
 			WARNING("--fps_limit ignored! \"" + args("fps_limit") + "\" must be a valid positive integer."); }
+	} if (args["worker-threads"]) { // Use =0 for one per CPU core
+		try { worker_threads = stoul(args("worker-threads")); } catch(...) {
+			WARNING("--worker-threads ignored! \"" + args("worker-threads") + "\" must be a valid positive integer."); }
 	} if (args["dbg-keys"]) {
 		DEBUG_show_keycode = true;
 	} if (args["interact"]) {
@@ -69,6 +69,7 @@ struct SimAppConfig : Config
 	bool  fixed_model_dt_enabled;
 	float fixed_model_dt;
 	unsigned fps_limit; // 0: no limit
+	unsigned worker_threads; // Of the job system; 0: one per CPU core
 
 	float player_idle_threshold; // s //!! Make it adjustable!
 
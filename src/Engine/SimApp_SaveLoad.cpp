@@ -22,8 +22,23 @@
     using std::make_unique_for_overwrite;
 #   include <cstddef>
     using std::byte; //!! It's fucked up in C++ tho: a byte[] buffer can't be used for file IO... Excellent.
+#   include <vector>
+    using std::vector;
+#   include <algorithm>
+    using std::min;
+#   include <atomic>
+#   include <stdexcept>
+    using std::runtime_error;
 #endif // DISABLE_SNAPSHOT_COMPRESSION
 
+#ifndef DISABLE_SNAPSHOT_COMPRESSION
+namespace {
+	// The snapshots are compressed in independent chunks (concatenated zstd frames),
+	// so they can be (de)compressed in parallel. (Older, single-frame ones still load.)
+	constexpr size_t SNAPSHOT_COMPRESSION_CHUNK = 4 * 1024 * 1024;
+}
+#endif
+
 namespace Szim {
 
 //----------------------------------------------------------------------------
@@ -63,15 +78,30 @@ bool SimApp::save_snapshot(const char* unsanitized_filename, SaveOpt flags)
 
 		//file << out.view();
 
-		// Compress (the whole blob in one go... <- !!IMPROVE)
-		auto data_size = out.tellp(); // or out.view().size()
-		auto cbuf_size = ZSTD_compressBound(data_size);
-		auto cbuf = make_unique_for_overwrite<char[]>(cbuf_size);
-		auto cfile_size = ZSTD_compress(cbuf.get(), cbuf_size, out.view().data(), data_size, 9);
-
-		if (!file.write(cbuf.get(), cfile_size) || file.bad()) {
-			print_error();
-			return false;
+		// Compress (still in memory, but chunked, in parallel)
+		auto data = out.view();
+		auto chunks = (data.size() + SNAPSHOT_COMPRESSION_CHUNK - 1) / SNAPSHOT_COMPRESSION_CHUNK;
+		vector<std::unique_ptr<char[]>> cbufs(chunks);
+		vector<size_t> csizes(chunks);
+		jobs.parallel_for("Compress snapshot", chunks, 1, [&](size_t first, size_t last) {
+			for (auto c = first; c < last; ++c) {
+				auto offset = c * SNAPSHOT_COMPRESSION_CHUNK;
+				auto size = min(SNAPSHOT_COMPRESSION_CHUNK, data.size() - offset);
+				auto cbuf_size = ZSTD_compressBound(size);
+				cbufs[c] = make_unique_for_overwrite<char[]>(cbuf_size);
+				csizes[c] = ZSTD_compress(cbufs[c].get(), cbuf_size, data.data() + offset, size, 9);
+			}
+		});
+
+		for (size_t c = 0; c < chunks; ++c) {
+			if (ZSTD_isError(csizes[c])) {
+				print_error("- ERROR: Couldn't compress the snapshot: "s + ZSTD_getErrorName(csizes[c]));
+				return false;
+			}
+			if (!file.write(cbufs[c].get(), csizes[c]) || file.bad()) {
+				print_error();
+				return false;
+			}
 		}
 		assert(out && !out.bad());
 	} else { // Not compressed
@@ -122,15 +152,37 @@ bool SimApp::load_snapshot(const char* unsanitized_filename)
 	in << file.rdbuf();
 	if (!in || in.bad()) { print_error(); return false; }
 
-	// Decompress it "in-place" (i.e. replacing the original compr. data; in one go, in-memory... <- !!IMPROVE)
+	// Decompress it "in-place" (i.e. replacing the original compr. data; in-memory, frames in parallel... <- !!IMPROVE)
 	if (!in.view().starts_with("MODEL") /*!! or !...<hopefully uniform various post-0.1 versions> !!*/) { // Compressed
 		try { // Mainly (or only?) for bad_alloc due to garbled data.
 			auto cbuf_size = in.view().size();
 			auto cbuf = in.view().data();
-			auto data_size = ZSTD_getFrameContentSize(cbuf, cbuf_size);
+
+			// Find the frames first...
+			struct Frame { size_t offset, size, data_offset, data_size; };
+			vector<Frame> frames;
+			size_t data_size = 0;
+			for (size_t pos = 0; pos < cbuf_size;) {
+				auto fsize = ZSTD_findFrameCompressedSize(cbuf + pos, cbuf_size - pos);
+				auto dsize = ZSTD_getFrameContentSize(cbuf + pos, cbuf_size - pos);
+				if (ZSTD_isError(fsize) || dsize == ZSTD_CONTENTSIZE_UNKNOWN || dsize == ZSTD_CONTENTSIZE_ERROR)
+					throw runtime_error("bad zstd frame");
+				frames.push_back({pos, fsize, data_size, dsize});
+				pos += fsize;
+				data_size += dsize;
+			}
+
+			// ...then decompress them, each right to its place:
 			auto data = make_unique_for_overwrite<char[]>(data_size);
-			auto dsize = ZSTD_decompress(data.get(), data_size, cbuf, cbuf_size);
-			assert(dsize == data_size);
+			std::atomic<bool> failed = false;
+			jobs.parallel_for("Decompress snapshot", frames.size(), 1, [&](size_t first, size_t last) {
+				for (auto f = first; f < last; ++f) {
+					auto& fr = frames[f];
+					if (ZSTD_decompress(data.get() + fr.data_offset, fr.data_size, cbuf + fr.offset, fr.size) != fr.data_size)
+						failed = true;
+				}
+			});
+			if (failed) throw runtime_error("bad zstd data");
 
 			//!!Only in c++26: in.str(string_view((char*)data.get(), data_size)); // or: reset, then: in.write(data.get(), data_size);
 			in.seekp(0, in.beg); // out
@@ -0,0 +1,51 @@
+#ifndef _TB7Q2XK9WM40NZ5HC81RV3JD6YF0LPS4_
+#define _TB7Q2XK9WM40NZ5HC81RV3JD6YF0LPS4_
+
+//============================================================================
+// Lock-free triple buffer: one producer, one consumer
+//
+// The producer fills back(), then publish()es it; the consumer acquire()s the
+// latest published one, and reads it via front() as long as it likes. Neither
+// of them ever waits for the other: the producer can publish any number of
+// times meanwhile (only the latest one is kept), and the consumer just keeps
+// reading the same one, if nothing new has been published.
+//
+// The three slots just rotate between the two sides, and they are never
+// cleared, so anything allocated in them (e.g. vector capacities) is reused.
+//
+//! Each side must always be used from the same thread (or with the usual
+//! hand-over sync. between its successive threads).
+//============================================================================
+
+#include <atomic>
+
+namespace Szim {
+
+template <typename T>
+class TripleBuffer
+{
+public:
+	// Producer side:
+	T& back() { return _slots[_back]; }
+	void publish() { _back = _shared.exchange(_back | FRESH, std::memory_order_acq_rel) & INDEX; }
+
+	// Consumer side:
+	bool acquire() // false: nothing new since the last one
+	{
+		if (!(_shared.load(std::memory_order_relaxed) & FRESH)) return false;
+		_front = _shared.exchange(_front, std::memory_order_acq_rel) & INDEX;
+		return true;
+	}
+	const T& front() const { return _slots[_front]; }
+
+protected:
+	static constexpr unsigned INDEX = 3, FRESH = 4; // The "shared" slot has not been acquired yet
+
+	T _slots[3];
+	unsigned _back = 0, _front = 1;       // Owned by the producer/consumer, resp.
+	std::atomic<unsigned> _shared{2};     // The third one, in between (+ FRESH)
+};
+
+} // namespace Szim
+
+#endif // _TB7Q2XK9WM40NZ5HC81RV3JD6YF0LPS4_
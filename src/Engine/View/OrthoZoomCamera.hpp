@@ -59,6 +59,11 @@ struct OrthoZoomCamera : Camera
 	// These are to check view(!) positions (per dim.):
 	bool visible_x(float view_pos_x) const { return view_pos_x >= _edge_x_min && view_pos_x < _edge_x_max; }
 	bool visible_y(float view_pos_y) const { return view_pos_y >= _edge_y_min && view_pos_y < _edge_y_max; }
+	// Also if only partly, for a circle (of view_radius) around a view position:
+	bool visible_in_view(Math::Vector2f view_pos, float view_radius = 0) const {
+		return view_pos.x + view_radius >= _edge_x_min && view_pos.x - view_radius < _edge_x_max
+		    && view_pos.y + view_radius >= _edge_y_min && view_pos.y - view_radius < _edge_y_max;
+	}
 
 	//!! This may not be best here, with all those awkward conversions:
 	//!! perhaps elsewhere in the rendering chain, closer to rasterizing,
@@ -67,5 +67,9 @@
 // Tuning...
 //
 
+#ifndef DISABLE_AVX_KERNEL // For toolchains that can't compile AVX code on demand (SSE2 would still be used)
+//# define DISABLE_AVX_KERNEL
+#endif
+
 
 #endif // _4059786V2MB67B5VB7I3C5_
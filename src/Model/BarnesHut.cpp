@@ -0,0 +1,200 @@
+// Must do this first for Tracy's winsock2.h has to precede any windows.h! :-/
+#include "extern/Tracy/public/tracy/Tracy.hpp"
+
+#include "Model/BarnesHut.hpp"
+
+#include "Engine/SimApp.hpp" // The interaction hooks
+
+#include <cassert>
+#include <cmath> // sqrt
+#include <algorithm> // min, max
+#include <limits>
+
+
+namespace Model {
+
+using namespace std;
+using namespace Math;
+
+
+//============================================================================
+void BarnesHutTree::build(const World& world)
+{
+ZoneScoped;
+	_nodes.clear(); //! Keeps the capacity, so no realloc. after the first few ticks.
+	_next_in_leaf.assign(world.bodies.size(), None);
+
+	// Find the bounding box of the (live) bodies first...
+	NumType x_min = numeric_limits<NumType>::max(), y_min = x_min;
+	NumType x_max = numeric_limits<NumType>::lowest(), y_max = x_max;
+	bool empty = true;
+	const auto& bodies = world.bodies;
+	for (size_t i = 0; i < bodies.size(); ++i) {
+		if (bodies.terminated(i)) continue;
+		x_min = min(x_min, bodies.px[i]); x_max = max(x_max, bodies.px[i]);
+		y_min = min(y_min, bodies.py[i]); y_max = max(y_max, bodies.py[i]);
+		empty = false;
+	}
+	if (empty) return;
+
+	// ...and make it a square (with some margin, for the rounding errors):
+	auto half = max(x_max - x_min, y_max - y_min) / 2 * NumType(1.001) + NumType(1);
+	_nodes.push_back({ .cx = (x_min + x_max) / 2, .cy = (y_min + y_max) / 2, .half = half });
+
+	for (Index i = 0; i < (Index)world.bodies.size(); ++i) {
+		if (bodies.terminated(i)) continue;
+		_insert(world, i);
+	}
+
+	// Finish the centers of mass:
+	for (auto& n : _nodes) {
+		if (n.mass > 0) { n.mx /= n.mass; n.my /= n.mass; }
+	}
+}
+
+//----------------------------------------------------------------------------
+BarnesHutTree::Index BarnesHutTree::_new_children(Index parent_ndx)
+{
+	auto first = (Index)_nodes.size();
+	//! Copying, as push_back would invalidate a reference to the parent:
+	auto cx = _nodes[parent_ndx].cx, cy = _nodes[parent_ndx].cy, h = _nodes[parent_ndx].half / 2;
+	_nodes.push_back({ .cx = cx - h, .cy = cy + h, .half = h }); // NW
+	_nodes.push_back({ .cx = cx + h, .cy = cy + h, .half = h }); // NE
+	_nodes.push_back({ .cx = cx - h, .cy = cy - h, .half = h }); // SW
+	_nodes.push_back({ .cx = cx + h, .cy = cy - h, .half = h }); // SE
+	_nodes[parent_ndx].first_child = first;
+	return first;
+}
+
+//----------------------------------------------------------------------------
+void BarnesHutTree::_insert(const World& world, Index body_ndx)
+{
+	const auto& bodies = world.bodies;
+
+	auto add_to = [this, &bodies](Index node_ndx, Index b) {
+		auto& n = _nodes[node_ndx];
+		n.mass += bodies.mass[b];
+		n.mx += bodies.px[b] * bodies.mass[b];
+		n.my += bodies.py[b] * bodies.mass[b];
+		n.r_max = max(n.r_max, bodies.r[b]);
+	};
+	const auto x = bodies.px[body_ndx], y = bodies.py[body_ndx];
+
+	Index n = 0;
+	for (unsigned depth = 0;; ++depth) {
+		add_to(n, body_ndx);
+
+		if (!_nodes[n].is_leaf()) {
+			n = _child_for(_nodes[n], x, y);
+			continue;
+		}
+
+		if (_nodes[n].body == None) { // Empty leaf: just take it
+			_nodes[n].body = body_ndx;
+			return;
+		}
+
+		if (depth >= MAX_DEPTH) { // Just chain it to the others already there
+			_next_in_leaf[body_ndx] = _nodes[n].body;
+			_nodes[n].body = body_ndx;
+			return;
+		}
+
+		// Occupied leaf: split it, and push the old tenant down one level
+		// (it's alone there, as only max-depth leaves can have more)...
+		auto old = _nodes[n].body;
+		_nodes[n].body = None;
+		_new_children(n);
+		auto c = _child_for(_nodes[n], bodies.px[old], bodies.py[old]);
+		add_to(c, old);
+		_nodes[c].body = old;
+		// ...then go on with the new one:
+		n = _child_for(_nodes[n], x, y);
+	}
+}
+
+
+//============================================================================
+void World::update_pairwise_interactions_BarnesHut(float dt, Szim::SimApp& app)
+// Same as the exact loop in Half mode (incl. calling the collision hooks once per
+// colliding pair, with the higher-index body as the "target"), except that the
+// gravity of distant groups of bodies is approximated by their center of mass.
+//
+//! NOTE: The force laws here are the "proper" ones of the Full loop, so Realistic
+//!       mode doesn't have the extra dt/distance factor of the Half loop!
+{
+ZoneScoped;
+	using enum GravityMode;
+
+	static BarnesHutTree tree; // Static to reuse its buffers across ticks
+	tree.build(*this);
+	if (tree.nodes().empty()) return;
+
+	const auto& nodes = tree.nodes();
+	const NumType theta2 = bh_theta * bh_theta;
+	const bool realistic = gravity_mode != Hyperbolic; // Experimental is the same as Realistic for now
+
+	// The force law (the pull from `mass` at `distance`, towards dx, dy):
+	auto pull = [&](size_t target, NumType dx, NumType dy, NumType distance, NumType mass) {
+		NumType a = gravity * mass / (distance * distance);
+		auto dv = Vector2<NumType>{dx * a, dy * a} * NumType(realistic ? dt/distance : dt);
+		bodies.vx[target] += dv.x;
+		bodies.vy[target] += dv.y;
+	};
+
+	static constexpr NumType SQRT2 = NumType(1.41421356);
+
+	// Explicit stack for the traversal: at most 3 siblings are waiting on each level
+	BarnesHutTree::Index stack[4 * BarnesHutTree::MAX_DEPTH + 4];
+
+	for (size_t i = 0; i < bodies.size(); ++i)
+	{
+		if (bodies.terminated(i)) continue;
+		const bool pulled = !bodies.superpower[i].gravity_immunity;
+		const auto tx = bodies.px[i], ty = bodies.py[i], tr = bodies.r[i];
+
+		unsigned top = 0;
+		stack[top++] = 0;
+		while (top) {
+			const auto& n = nodes[stack[--top]];
+			if (n.mass <= 0) continue; // Empty cell
+
+			auto dx = n.mx - tx,
+			     dy = n.my - ty;
+			auto d2 = dx*dx + dy*dy;
+			auto side = n.half * 2;
+
+			// Far enough to treat the whole cell as one body? (And nothing in it could touch the target?)
+			if (side * side < theta2 * d2) {
+				auto distance = sqrt(d2);
+				if (distance > side * SQRT2 + n.r_max + tr) {
+					if (pulled) pull(i, dx, dy, distance, n.mass);
+					continue;
+				}
+			}
+
+			if (!n.is_leaf()) {
+				for (int c = 0; c < 4; ++c) stack[top++] = n.first_child + c;
+				continue;
+			}
+
+			// Leaf: exact interactions with its bodies
+			for (auto j = n.body; j != BarnesHutTree::None; j = tree.next_in_leaf(j)) {
+				if ((size_t)j == i) continue;
+
+				auto sdx = bodies.px[j] - tx,
+				     sdy = bodies.py[j] - ty;
+				auto distance = Math::mag2(sdx, sdy);
+
+				if (is_colliding(i, j, distance)) {
+					// Only once per pair, like the Half loop does:
+					if ((size_t)j < i && !broadphase) _collide(i, j, distance, app);
+				} else if (pulled) {
+					pull(i, sdx, sdy, distance, bodies.mass[j]);
+				}
+			}
+		}
+	}
+}
+
+} // namespace Model
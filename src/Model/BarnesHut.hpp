@@ -0,0 +1,65 @@
+#ifndef _BH7Q40T8YN5C2V9M46WX1R3JD7K0PZ5E_
+#define _BH7Q40T8YN5C2V9M46WX1R3JD7K0PZ5E_
+
+#include "Model/World.hpp"
+
+#include <vector>
+#include <cstdint>
+
+namespace Model {
+
+//============================================================================
+// Barnes-Hut quadtree for approximating the gravity of many bodies
+// in O(n log n), instead of the O(n²) exact pairwise loop.
+//
+// The tree is meant to be rebuilt from scratch in every tick (positions
+// change all the time anyway), so it's just a flat array of nodes, reused
+// across the builds to avoid reallocating it over and over again.
+//
+// Bodies are referred to by their index in World::bodies.
+//
+class BarnesHutTree
+{
+public:
+	using NumType = World::NumType;
+	using Index = int32_t; //! Fine even for millions of bodies, and keeps the nodes small.
+	static constexpr Index None = -1;
+
+	// Coincident (or nearly so) bodies would make the tree infinitely deep,
+	// so beyond this the leaves just collect all the bodies they get:
+	static constexpr unsigned MAX_DEPTH = 48;
+
+	struct Node {
+		NumType cx, cy;    // Center of the cell
+		NumType half;      // Half of the side length of the (square) cell
+		NumType mass = 0;
+		NumType mx = 0, my = 0; // Mass-weighted position sum -> center of mass, when finished
+		NumType r_max = 0; // Largest body radius in the cell (for not missing collisions)
+		Index first_child = None; // The 4 children are always allocated together, in this order: NW, NE, SW, SE
+		Index body = None;        // Leaves only: first body in the cell (see _next_in_leaf for the rest)
+
+		bool is_leaf() const { return first_child == None; }
+	};
+
+	void build(const World& world);
+
+	const std::vector<Node>& nodes() const { return _nodes; }
+	Index next_in_leaf(Index body_ndx) const { return _next_in_leaf[body_ndx]; }
+
+	// Stats (mostly for tuning/debugging)
+	size_t node_count() const { return _nodes.size(); }
+
+protected:
+	Index _new_children(Index parent_ndx);
+	Index _child_for(const Node& n, NumType x, NumType y) const {
+		return n.first_child + (x >= n.cx ? 1 : 0) + (y < n.cy ? 2 : 0);
+	}
+	void _insert(const World& world, Index body_ndx);
+
+	std::vector<Node>  _nodes;
+	std::vector<Index> _next_in_leaf; // Per body: the next body in the same (max-depth) leaf
+};
+
+} // namespace Model
+
+#endif // _BH7Q40T8YN5C2V9M46WX1R3JD7K0PZ5E_
@@ -1,6 +1,7 @@
 #include "Emitter.hpp"
 
 #include "Engine/SimApp.hpp"
+#include "Model/World.hpp" // particles
 
 
 namespace Model {
@@ -15,13 +16,11 @@ Emitter::Emitter(const Config& emitter_cfg, Szim::SimApp& app)
 //----------------------------------------------------------------------------
 //!! - Move to SimApp!
 //!! - Decouple from the entity() query: pass it the object, not the index!
-//!!   (Only that `resize_shape(emitter_ndx, emitter.r/emitter_old_r);` uses it!
-//!!   Could be done by callers, or even be a follow-up callback, if necessary.)
 //!! - It still calls add_entity() (so still can't be a free function (or class)),
 //!!   but that really could be a callback than...
 void Emitter::emit_particles(size_t emitter_ndx, unsigned n, Math::Vector2<NumT> nozzles[])
 {
-	auto& emitter = app.entity(emitter_ndx); // Not const: will deplete!
+	const auto emitter = app.const_entity(emitter_ndx); //! A copy, as adding the particles would invalidate a ref.!
 		//!! Also take care of other threads possibly deleting the emitter later on! :-o
 
 //if (!cfg.create_mass) cerr <<"DBG> emitter.mass BEFORE burst: "<< emitter.mass <<'\n';
@@ -36,12 +35,14 @@ void Emitter::emit_particles(size_t emitter_ndx, unsigned n, Math::Vector2<NumT>
 
 	auto v_range = emitter.r * cfg.velocity_divergence; //!! Ugh... by magic, right? :-o :-/
 
-	auto emitter_old_r = emitter.r;
+	auto emitter_mass = emitter.mass; // Will deplete (unless cfg.create_mass)!
+
+	if (!cfg.light_particles) app.world().bodies.reserve_more(n);
 
 	for (unsigned i = 0; i < n; ++i) {
 		auto particle_mass = cfg.particle_mass_min + (cfg.particle_mass_max - cfg.particle_mass_min) * float(rand())/RAND_MAX;
 
-		if (!cfg.create_mass && emitter.mass < particle_mass) {
+		if (!cfg.create_mass && emitter_mass < particle_mass) {
 //cerr << "- Not enough mass to emit particle!\n";
 			continue;
 		}
@@ -53,15 +54,24 @@ void Emitter::emit_particles(size_t emitter_ndx, unsigned n, Math::Vector2<NumT>
 		                          //!!...Jesus, these "hamfixted" pseudo Δt "factors"...
 		if (nozzles) p += nozzles[i] * emitter.r; // Scale to its "bounding sphere"...
 
-		[[maybe_unused]] auto pndx = app.add_entity({ //!! Refact. to only use World::add_body directly!
-			.lifetime = cfg.particle_lifetime,
-			.density = cfg.particle_density,
-			.p = p,
-			.v = { (rand() * v_range) / RAND_MAX - v_range/2 + emitter.v.x * cfg.v_factor + cfg.eject_velocity.x,
-			       (rand() * v_range) / RAND_MAX - v_range/2 + emitter.v.y * cfg.v_factor + cfg.eject_velocity.y },
-			.color = cfg.color,
-			.mass = particle_mass,
-		});
+		Math::Vector2<NumT> v = { (rand() * v_range) / RAND_MAX - v_range/2 + emitter.v.x * cfg.v_factor + cfg.eject_velocity.x,
+		                          (rand() * v_range) / RAND_MAX - v_range/2 + emitter.v.y * cfg.v_factor + cfg.eject_velocity.y };
+
+		if (cfg.light_particles) {
+			// Same size as the body would have (see Body::recalc()), but nothing else of it:
+			app.world().particles.emit(p.x, p.y, v.x, v.y,
+				Phys::radius_from_mass_and_density(particle_mass, cfg.particle_density),
+				cfg.particle_lifetime, cfg.color);
+		} else {
+			[[maybe_unused]] auto pndx = app.add_entity({ //!! Refact. to only use World::add_body directly!
+				.lifetime = cfg.particle_lifetime,
+				.density = cfg.particle_density,
+				.p = p,
+				.v = v,
+				.color = cfg.color,
+				.mass = particle_mass,
+			});
+		}
 //cerr <<"DBG> particle.r: "<< entity(pndx).r <<'\n';
 
 //cerr <<"DBG> emitter v:  "<< emitter.v.x <<", "<< emitter.v.y <<'\n';
@@ -69,18 +79,19 @@ void Emitter::emit_particles(size_t emitter_ndx, unsigned n, Math::Vector2<NumT>
 //cerr <<"     - part. v:  "<< entity(pndx).v.x <<", "<< entity(entity_count()-1).v.y <<'\n';
 
 		if (!cfg.create_mass) {
-			emitter.mass -= particle_mass;
+			emitter_mass -= particle_mass;
 //cerr <<"DBG> Decreasing emitter.mass by: "<< particle_mass <<'\n';
 		}
 	}
 
 	if (!cfg.create_mass) {
-		assert(emitter.mass >= 0); // See the actual run-time check above!
-//cerr <<"DBG> emitter.r before recalc: "<< emitter.r <<'\n';
-		emitter.recalc();
-//cerr <<"DBG> emitter.r after recalc: "<< emitter.r <<'\n';
-		app.resize_shape(emitter_ndx, float(emitter.r/emitter_old_r));
-//cerr <<"DBG> emitter.mass AFTER burst: "<< emitter.mass <<'\n';
+		auto depleted = app.entity(emitter_ndx);
+		depleted.mass = emitter_mass;
+		assert(depleted.mass >= 0); // See the actual run-time check above!
+//cerr <<"DBG> emitter.r before recalc: "<< depleted.r <<'\n';
+		depleted.recalc(); // (The view follows the new r by itself.)
+//cerr <<"DBG> emitter.r after recalc: "<< depleted.r <<'\n';
+//cerr <<"DBG> emitter.mass AFTER burst: "<< depleted.mass <<'\n';
 	}
 } // emit_particles
 
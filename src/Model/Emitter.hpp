@@ -29,6 +29,7 @@ public:
 		NumT particle_mass_min{};
 		NumT particle_mass_max{};
 		uint32_t color = 0x706080; // 0xRRGGBB
+		bool  light_particles = false; // Emit into World::particles (see ParticlePool), not as new bodies
 	};
 
 	//----------------------------------------------------------------------------
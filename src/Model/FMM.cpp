@@ -0,0 +1,326 @@
+// Must do this first for Tracy's winsock2.h has to precede any windows.h! :-/
+#include "extern/Tracy/public/tracy/Tracy.hpp"
+
+#include "Model/FMM.hpp"
+
+#include "Engine/SimApp.hpp" // jobs
+
+#include <cmath> // sqrt, ceil, log
+#include <algorithm> // min, max, clamp
+#include <limits>
+#include <iostream>
+	using std::cerr;
+
+
+namespace Model {
+
+using namespace std;
+
+//============================================================================
+void FastMultipole::evaluate(const World& world, unsigned order, Szim::SimApp& app)
+{
+ZoneScoped;
+	const auto& bodies = world.bodies;
+	const auto n = bodies.size();
+	_field.assign(n, Complex{});
+
+	// Split the work over the workers (each cell/body is only written by one of
+	// them, so it's deterministic), unless it's too small to bother:
+	auto for_each = [&](const char* name, size_t count, size_t grain, auto&& fn) {
+		if (world.threads != 1 && count > grain) {
+			app.jobs.parallel_for(name, count, grain,
+				[&](size_t first, size_t last) { for (auto k = first; k < last; ++k) fn(k); },
+				world.threads);
+		} else {
+			for (size_t k = 0; k < count; ++k) fn(k);
+		}
+	};
+
+	// The (real) matrices of the translations (once; see _translate())...
+	if (_m2l.empty()) {
+		constexpr unsigned N = 2*MAX_ORDER + 2, S = MAX_ORDER + 1;
+		vector<double> binomial(N * N, 0.0); // C(i, k) at [i * N + k]
+		for (unsigned i = 0; i < N; ++i) {
+			binomial[i * N] = 1;
+			for (unsigned k = 1; k <= i; ++k)
+				binomial[i * N + k] = binomial[(i-1) * N + k-1] + (k < i ? binomial[(i-1) * N + k] : 0);
+		}
+		_m2m.assign(S * S, 0.0); _l2l.assign(S * S, 0.0); _m2l.assign(S * S, 0.0);
+		for (unsigned m = 0; m < S; ++m)
+			for (unsigned k = 0; k < S; ++k) {
+				if (k <= m) _m2m[m * S + k] = binomial[m * N + k];
+				if (k >= m) _l2l[m * S + k] = binomial[k * N + m];
+				_m2l[m * S + k] = (m & 1 ? -1 : 1) * binomial[(k + m) * N + m];
+			}
+	}
+	_order = clamp(order, MIN_ORDER, MAX_ORDER);
+	const unsigned P = _order + 1; // Terms per expansion
+
+	// The root cell: the bounding box of the live bodies, squared up (like in BarnesHut.cpp)...
+	double x_min = numeric_limits<double>::max(), y_min = x_min;
+	double x_max = numeric_limits<double>::lowest(), y_max = x_max;
+	size_t live = 0;
+	for (size_t i = 0; i < n; ++i) {
+		if (bodies.terminated(i)) continue;
+		x_min = min(x_min, double(bodies.px[i])); x_max = max(x_max, double(bodies.px[i]));
+		y_min = min(y_min, double(bodies.py[i])); y_max = max(y_max, double(bodies.py[i]));
+		++live;
+	}
+	if (live < 2) return;
+	_side = max(x_max - x_min, y_max - y_min) * 1.001 + 1;
+	_x0 = (x_min + x_max - _side) / 2;
+	_y0 = (y_min + y_max - _side) / 2;
+
+	// ...and the depth: ~LEAF_TARGET bodies per leaf on average (the interaction
+	// lists need at least 2 levels), or deeper, if they are crowded somewhere, as
+	// the near field would take over then (sum of count² over the leaves: the pairs
+	// in the same leaf, ~1/9 of the near field):
+	_levels = clamp(unsigned(ceil(log(double(live) / LEAF_TARGET) / log(4.0))), 2u, MAX_LEVEL);
+	{
+		static vector<uint32_t> fine, coarse; // Reused across ticks
+		constexpr unsigned FINE_DIM = 1u << MAX_LEVEL;
+		fine.assign(FINE_DIM * FINE_DIM, 0);
+		for (size_t i = 0; i < n; ++i) {
+			if (bodies.terminated(i)) continue;
+			auto z = _normalized(world, i);
+			++fine[min(unsigned(z.imag() * FINE_DIM), FINE_DIM - 1) * FINE_DIM + min(unsigned(z.real() * FINE_DIM), FINE_DIM - 1)];
+		}
+		for (; _levels < MAX_LEVEL; ++_levels) {
+			auto shift = MAX_LEVEL - _levels;
+			coarse.assign(size_t(1) << (2 * _levels), 0);
+			for (unsigned y = 0; y < FINE_DIM; ++y)
+				for (unsigned x = 0; x < FINE_DIM; ++x)
+					coarse[((y >> shift) << _levels) + (x >> shift)] += fine[y * FINE_DIM + x];
+			double pairs = 0;
+			for (auto c : coarse) pairs += double(c) * c;
+			if (pairs <= 2.0 * LEAF_TARGET * double(live)) break;
+		}
+	}
+	const unsigned L = _levels;
+	const unsigned leaf_dim = 1u << L;
+
+	// Sort the bodies into the leaves (counting sort, so it stays in index order within a leaf):
+	_leaf_start.assign(leaf_dim * leaf_dim + 1, 0);
+	_leaf_of.resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		if (bodies.terminated(i)) continue;
+		auto z = _normalized(world, i);
+		auto x = min(unsigned(z.real() * leaf_dim), leaf_dim - 1),
+		     y = min(unsigned(z.imag() * leaf_dim), leaf_dim - 1);
+		_leaf_of[i] = y * leaf_dim + x;
+		++_leaf_start[_leaf_of[i] + 1];
+	}
+	for (unsigned c = 0; c < leaf_dim * leaf_dim; ++c) _leaf_start[c + 1] += _leaf_start[c];
+	_leaf_bodies.resize(live);
+	{
+		static vector<uint32_t> fill; // Reused across ticks
+		fill.assign(_leaf_start.begin(), _leaf_start.end() - 1);
+		for (size_t i = 0; i < n; ++i)
+			if (!bodies.terminated(i)) _leaf_bodies[fill[_leaf_of[i]]++] = uint32_t(i);
+	}
+
+	for (unsigned l = 0; l <= L; ++l) {
+		auto cells = size_t(1u << l) * (1u << l);
+		_multipole[l].assign(cells * P, Complex{});
+		_local[l].assign(cells * P, Complex{});
+		_count[l].assign(cells, 0);
+	}
+
+	// P2M: the multipoles of the leaves, b_k = sum m_j (z_j - c)^k...
+	for_each("FMM P2M", size_t(leaf_dim) * leaf_dim, 64, [&](size_t c) {
+		auto* b = &_multipole[L][c * P];
+		auto center = _center(L, unsigned(c % leaf_dim), unsigned(c / leaf_dim));
+		for (auto k = _leaf_start[c]; k < _leaf_start[c + 1]; ++k) {
+			auto i = _leaf_bodies[k];
+			auto w = _normalized(world, i) - center;
+			Complex wk = double(bodies.mass[i]);
+			for (unsigned p = 0; p < P; ++p) { b[p] += wk; wk *= w; }
+		}
+		_count[L][c] = _leaf_start[c + 1] - _leaf_start[c];
+	});
+
+	// M2M: ...shifted up to the parents: b'_m = sum_{k<=m} C(m,k) b_k d^(m-k), d = c_child - c_parent
+	for (unsigned l = L; l > 0; --l) {
+		const unsigned dim = 1u << (l-1);
+		for_each("FMM M2M", size_t(dim) * dim, 64, [&](size_t c) {
+			auto px = unsigned(c % dim), py = unsigned(c / dim);
+			auto* parent = &_multipole[l-1][c * P];
+			auto pc = _center(l-1, px, py);
+			for (unsigned q = 0; q < 4; ++q) {
+				auto cx = 2*px + (q & 1), cy = 2*py + (q >> 1);
+				auto child_ndx = size_t(cy) * (2*dim) + cx;
+				if (!_count[l][child_ndx]) continue;
+				_count[l-1][c] += _count[l][child_ndx];
+				const auto* b = &_multipole[l][child_ndx * P];
+				auto d = _center(l, cx, cy) - pc;
+				_translate(_m2m.data(), b, _reciprocal(d), parent, d, 1);
+			}
+		});
+	}
+
+	// M2L + L2L, top-down: each cell gets its parent's local expansion shifted to
+	// its center (c'_m = sum_{k>=m} C(k,m) c_k d^(k-m)), plus the multipoles of its
+	// interaction list (the children of the parent's neighbours, not adjacent to it)
+	// converted: c_m = (-1)^m sum_k C(k+m,m) b_k / t^(k+m+1), t = c_here - c_there
+	for (unsigned l = 2; l <= L; ++l) {
+		const int dim = 1 << l;
+		for_each("FMM M2L", size_t(dim) * dim, 16, [&](size_t c) {
+			auto x = int(c % dim), y = int(c / dim);
+			if (!_count[l][c]) return; // Nothing to evaluate it at (down there)
+			auto* loc = &_local[l][c * P];
+			auto here = _center(l, x, y);
+
+			if (l > 2) { // (The level-2 cells have no far field from above)
+				const auto* pl = &_local[l-1][(size_t(y/2) * (dim/2) + x/2) * P];
+				auto d = here - _center(l-1, x/2, y/2);
+				_translate(_l2l.data(), pl, d, loc, _reciprocal(d), 1);
+			}
+
+			int x_lo = max(0, (x/2 - 1) * 2), x_hi = min(dim - 1, (x/2 + 1) * 2 + 1),
+			    y_lo = max(0, (y/2 - 1) * 2), y_hi = min(dim - 1, (y/2 + 1) * 2 + 1);
+			for (int sy = y_lo; sy <= y_hi; ++sy)
+			for (int sx = x_lo; sx <= x_hi; ++sx) {
+				if (abs(sx - x) <= 1 && abs(sy - y) <= 1) continue; // Adjacent: not separated enough
+				auto src = size_t(sy) * dim + sx;
+				if (!_count[l][src]) continue;
+				const auto* b = &_multipole[l][src * P];
+				auto t_inv = _reciprocal(here - _center(l, sx, sy));
+				_translate(_m2l.data(), b, t_inv, loc, t_inv, t_inv);
+			}
+		});
+	}
+
+	// L2P + the near field: each body gets the local expansion of its leaf, plus
+	// the direct sum of the bodies in the 3x3 leaves around it (skipping the ones
+	// touching it, like the exact loop):
+	for_each("FMM L2P", _leaf_bodies.size(), 256, [&](size_t k) {
+		auto i = _leaf_bodies[k];
+		auto c = _leaf_of[i];
+		const auto* loc = &_local[L][c * P];
+		auto u = _normalized(world, i) - _center(L, c % leaf_dim, c / leaf_dim);
+		Complex far{};
+		for (unsigned p = P; p-- > 0; ) far = far * u + loc[p];
+
+		Complex near{};
+		const auto zi = Complex(bodies.px[i], bodies.py[i]);
+		int x = int(c % leaf_dim), y = int(c / leaf_dim);
+		for (int ny = max(0, y-1); ny <= min(int(leaf_dim) - 1, y+1); ++ny)
+		for (int nx = max(0, x-1); nx <= min(int(leaf_dim) - 1, x+1); ++nx) {
+			auto nc = unsigned(ny) * leaf_dim + unsigned(nx);
+			for (auto kk = _leaf_start[nc]; kk < _leaf_start[nc + 1]; ++kk) {
+				auto j = _leaf_bodies[kk];
+				if (j == i) continue;
+				auto distance = Math::mag2(bodies.px[j] - bodies.px[i], bodies.py[j] - bodies.py[i]);
+				if (world.is_colliding(i, j, distance)) continue;
+				near += double(bodies.mass[j]) * _reciprocal(zi - Complex(bodies.px[j], bodies.py[j]));
+			}
+		}
+		_field[i] = far / _side + near;
+	});
+}
+
+//----------------------------------------------------------------------------
+void FastMultipole::_translate(const double* A, const Complex* in, Complex pre, Complex* out, Complex post, Complex post0) const
+// out[m] += post0 * post^m * sum_k A[m][k] * in[k] * pre^k
+//
+// All three translations can be factored like this, with only real (binomial)
+// coefficients left in the P x P part (the bulk of the work), so that's just
+// plain (vectorizable) multiply-adds, not complex products:
+//
+//   M2M: pre = 1/d, post = d,   post0 = 1
+//   L2L: pre = d,   post = 1/d, post0 = 1
+//   M2L: pre = post = post0 = 1/t
+{
+	constexpr unsigned S = MAX_ORDER + 1;
+	const unsigned P = _order + 1;
+
+	double re[S], im[S];
+	Complex pk = 1;
+	for (unsigned k = 0; k < P; ++k) {
+		auto v = in[k] * pk;
+		re[k] = v.real(); im[k] = v.imag();
+		pk *= pre;
+	}
+
+	Complex qm = post0;
+	for (unsigned m = 0; m < P; ++m) {
+		const auto* row = A + m * S;
+		double sr = 0, si = 0;
+		for (unsigned k = 0; k < P; ++k) { sr += row[k] * re[k]; si += row[k] * im[k]; }
+		out[m] += qm * Complex(sr, si);
+		qm *= post;
+	}
+}
+
+//----------------------------------------------------------------------------
+void FastMultipole::direct_sum(const World& world, vector<Complex>& field, Szim::SimApp& app)
+{
+ZoneScoped;
+	const auto& bodies = world.bodies;
+	const auto n = bodies.size();
+	field.assign(n, Complex{});
+
+	auto sum_for = [&](size_t i) {
+		if (bodies.terminated(i)) return;
+		const auto zi = Complex(bodies.px[i], bodies.py[i]);
+		Complex f{};
+		for (size_t j = 0; j < n; ++j) {
+			if (j == i || bodies.terminated(j)) continue;
+			auto distance = Math::mag2(bodies.px[j] - bodies.px[i], bodies.py[j] - bodies.py[i]);
+			if (world.is_colliding(i, j, distance)) continue;
+			f += double(bodies.mass[j]) * _reciprocal(zi - Complex(bodies.px[j], bodies.py[j]));
+		}
+		field[i] = f;
+	};
+
+	if (world.threads != 1) {
+		app.jobs.parallel_for("FMM check", n, 16,
+			[&](size_t first, size_t last) { for (auto i = first; i < last; ++i) sum_for(i); },
+			world.threads);
+	} else {
+		for (size_t i = 0; i < n; ++i) sum_for(i);
+	}
+}
+
+
+//============================================================================
+void World::update_pairwise_interactions_FMM(float dt, Szim::SimApp& app)
+// The gravity of all the pairs (with the "proper" Hyperbolic law of the Full
+// loop, like in BarnesHut.cpp) via the FMM (see FMM.hpp), with the collisions
+// found by the spatial hash (see update_collisions_broadphase()), so the hooks
+// are called before the gravity here, not during it.
+//
+//! NOTE: Only the adjacent leaves check for contact, so touching pairs far apart
+//!       (i.e. huge bodies) still pull each other (unlike in the exact loop).
+{
+ZoneScoped;
+	if (!broadphase) update_collisions_broadphase(app); // (Otherwise already done.)
+
+	static FastMultipole fmm; // Static to reuse its buffers across ticks
+	fmm.evaluate(*this, fmm_order, app);
+	const auto& f = fmm.field();
+
+	// accel. = -G * conj(f):
+	for (size_t i = 0; i < bodies.size(); ++i) {
+		if (bodies.terminated(i) || bodies.superpower[i].gravity_immunity) continue;
+		bodies.vx[i] += NumType(-gravity * f[i].real() * dt);
+		bodies.vy[i] += NumType( gravity * f[i].imag() * dt);
+	}
+
+	if (fmm_check) {
+		static vector<FastMultipole::Complex> exact; // Reused across ticks
+		FastMultipole::direct_sum(*this, exact, app);
+		double err_max = 0, err2 = 0, f2 = 0;
+		for (size_t i = 0; i < bodies.size(); ++i) {
+			if (bodies.terminated(i)) continue;
+			auto e = abs(f[i] - exact[i]);
+			if (auto fi = abs(exact[i]); fi > 0) err_max = max(err_max, e / fi);
+			err2 += e * e;
+			f2 += norm(exact[i]);
+		}
+		cerr << "FMM (order " << fmm_order << ", " << fmm.levels() << " levels, " << bodies.size() << " bodies): "
+		     << "max. rel. error: " << err_max << ", RMS error / RMS force: " << (f2 > 0 ? sqrt(err2 / f2) : 0) << "\n";
+	}
+}
+
+} // namespace Model
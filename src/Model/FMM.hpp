@@ -0,0 +1,94 @@
+#ifndef _FM5T8K2WQ0Z7HC34NX9RB61VJD0YLP3G_
+#define _FM5T8K2WQ0Z7HC34NX9RB61VJD0YLP3G_
+
+#include "Model/World.hpp"
+
+#include <vector>
+#include <complex>
+#include <cstdint>
+
+namespace Szim { class SimApp; }
+
+namespace Model {
+
+//============================================================================
+// 2-D Fast Multipole Method for the gravity of (very) many bodies, in O(n)
+//
+// With the Hyperbolic law (the default), the pull of a body is proportional to
+// 1/distance, i.e. it's the 2-D (logarithmic) gravity, the field of which is
+// just the complex function
+//
+//    f(z) = sum_j m_j / (z - z_j),    accel(z) = -G * conj(f(z)),
+//
+// so it can be expanded in complex power series (Greengard & Rokhlin): around
+// the centers of the cells of a uniform quadtree, the multipole expansions
+// (of the bodies inside) are summed up the tree, then converted into local
+// expansions for the well-separated cells on each level, and passed down the
+// tree, to be evaluated at the bodies in the leaves. The adjacent leaves are
+// summed up directly (skipping the colliding pairs, like the exact loop).
+//
+// The error shrinks geometrically with the `order` of the expansions (about
+// 0.55^order in the worst case; --fmm-check reports it against the direct sum).
+//
+//! Only for the Hyperbolic law: with the Realistic one (1/distance²), the
+//! field is not analytic any more (see World::update_pairwise_interactions_FMM()).
+//
+// The expansions are calculated in double (whatever the model's number type),
+// with the coordinates normalized to the root cell, to keep the powers of the
+// distances in range even at high orders.
+//
+class FastMultipole
+{
+public:
+	using NumType = World::NumType;
+	using Complex = std::complex<double>;
+
+	static constexpr unsigned MIN_ORDER = 2, MAX_ORDER = 30;
+	static constexpr unsigned MAX_LEVEL = 8;   // 4^8 leaves; beyond that (~1M bodies) the leaves just get fuller
+	static constexpr unsigned LEAF_TARGET = 16; // Avg. bodies per leaf to aim for (balancing the near and far parts)
+
+	// Calculate f(z_i) (see above) for each live body (0 for the terminated ones);
+	// parallelized with app.jobs, unless world.threads == 1:
+	void evaluate(const World& world, unsigned order, Szim::SimApp& app);
+	const std::vector<Complex>& field() const { return _field; }
+
+	// The same f(z_i), by the direct O(n²) sum, for checking:
+	static void direct_sum(const World& world, std::vector<Complex>& field, Szim::SimApp& app);
+
+	unsigned levels() const { return _levels; }
+
+protected:
+	unsigned _order = 0;  // Expansion terms: 0..order
+	unsigned _levels = 0; // The leaves are at this level (the root is 0)
+	double _x0 = 0, _y0 = 0, _side = 1; // The root cell
+
+	// Per level, (order+1) coefficients for each cell (index: y * 2^level + x):
+	std::vector<Complex> _multipole[MAX_LEVEL + 1];
+	std::vector<Complex> _local[MAX_LEVEL + 1];
+	std::vector<uint32_t> _count[MAX_LEVEL + 1]; // Bodies in the cell (to skip the empty ones)
+
+	// The bodies sorted by leaf (counting sort): leaf c has _leaf_bodies[_leaf_start[c] .. _leaf_start[c+1])
+	std::vector<uint32_t> _leaf_start;
+	std::vector<uint32_t> _leaf_bodies;
+	std::vector<uint32_t> _leaf_of; // Per body
+
+	// The translation matrices, (MAX_ORDER+1)² each (see _translate()):
+	std::vector<double> _m2m, _l2l, _m2l;
+	void _translate(const double* A, const Complex* in, Complex pre, Complex* out, Complex post, Complex post0) const;
+
+	std::vector<Complex> _field; // Per body
+
+	Complex _center(unsigned level, unsigned x, unsigned y) const {
+		auto w = 1.0 / double(1u << level);
+		return { (x + 0.5) * w, (y + 0.5) * w };
+	}
+	// 1/z, without the (slow) inf/NaN-safe generic complex division (z is never 0 here):
+	static Complex _reciprocal(Complex z) { return conj(z) / norm(z); }
+	Complex _normalized(const World& world, size_t i) const {
+		return { (double(world.bodies.px[i]) - _x0) / _side, (double(world.bodies.py[i]) - _y0) / _side };
+	}
+};
+
+} // namespace Model
+
+#endif // _FM5T8K2WQ0Z7HC34NX9RB61VJD0YLP3G_
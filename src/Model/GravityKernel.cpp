@@ -0,0 +1,378 @@
+// Must do this first for Tracy's winsock2.h has to precede any windows.h! :-/
+#include "extern/Tracy/public/tracy/Tracy.hpp"
+
+#include "Model/GravityKernel.hpp"
+#include "Model/GravityKernel_impl.hpp"
+
+#include "Model/World.hpp"
+#include "Engine/SimApp.hpp" // The interaction hooks
+
+#include <cmath> // sqrt
+#include <vector>
+#include <algorithm> // max
+#include <iostream>
+	using std::cerr;
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+# define _GK_X86_
+# include <emmintrin.h> // SSE2
+# ifdef _MSC_VER
+#  include <intrin.h> // __cpuid, _xgetbv
+# endif
+# if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define _GK_SSE2_
+# endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+# define _GK_NEON_
+# include <arm_neon.h>
+#endif
+
+
+namespace Model::GravityKernel {
+
+namespace { //----------------------------------------------------------------
+
+//----------------------------------------------------------------------------
+// Plain arrays, for the compiler to vectorize as it can (also the scalar tail, with N = 1)
+template <unsigned LANES>
+struct GenericLanes
+{
+	static constexpr unsigned N = LANES;
+	struct F { float v[N]; };
+	struct M { bool  v[N]; };
+
+#define _GK_EACH_(expr) { F r; for (unsigned i = 0; i < N; ++i) r.v[i] = (expr); return r; }
+	static F load(const float* p)    _GK_EACH_(p[i])
+	static void store(float* p, F a) { for (unsigned i = 0; i < N; ++i) p[i] = a.v[i]; }
+	static F set(float x)            _GK_EACH_(x)
+	static F add(F a, F b)           _GK_EACH_(a.v[i] + b.v[i])
+	static F sub(F a, F b)           _GK_EACH_(a.v[i] - b.v[i])
+	static F mul(F a, F b)           _GK_EACH_(a.v[i] * b.v[i])
+	static F div(F a, F b)           _GK_EACH_(a.v[i] / b.v[i])
+	static F sqrt(F a)               _GK_EACH_(std::sqrt(a.v[i]))
+	static F select(M m, F a)        _GK_EACH_(m.v[i] ? a.v[i] : 0.f)
+#undef _GK_EACH_
+#define _GK_EACH_(expr) { M r; for (unsigned i = 0; i < N; ++i) r.v[i] = (expr); return r; }
+	static M le(F a, F b)            _GK_EACH_(a.v[i] <= b.v[i])
+	static M gt(F a, F b)            _GK_EACH_(a.v[i] > b.v[i])
+	static M and_(M a, M b)          _GK_EACH_(a.v[i] && b.v[i])
+	static M and_not(M a, M b)       _GK_EACH_(a.v[i] && !b.v[i])
+#undef _GK_EACH_
+	static unsigned bits(M m) { unsigned r = 0; for (unsigned i = 0; i < N; ++i) r |= unsigned(m.v[i]) << i; return r; }
+	static float hsum(F a) { float s = 0; for (unsigned i = 0; i < N; ++i) s += a.v[i]; return s; }
+};
+
+#ifdef _GK_SSE2_
+//----------------------------------------------------------------------------
+struct SSE2Lanes
+{
+	static constexpr unsigned N = 4;
+	using F = __m128;
+	using M = __m128;
+
+	static F load(const float* p)    { return _mm_loadu_ps(p); }
+	static void store(float* p, F a) { _mm_storeu_ps(p, a); }
+	static F set(float x)            { return _mm_set1_ps(x); }
+	static F add(F a, F b)           { return _mm_add_ps(a, b); }
+	static F sub(F a, F b)           { return _mm_sub_ps(a, b); }
+	static F mul(F a, F b)           { return _mm_mul_ps(a, b); }
+	static F div(F a, F b)           { return _mm_div_ps(a, b); }
+	static F sqrt(F a)               { return _mm_sqrt_ps(a); }
+	static F select(M m, F a)        { return _mm_and_ps(m, a); }
+	static M le(F a, F b)            { return _mm_cmple_ps(a, b); }
+	static M gt(F a, F b)            { return _mm_cmpgt_ps(a, b); }
+	static M and_(M a, M b)          { return _mm_and_ps(a, b); }
+	static M and_not(M a, M b)       { return _mm_andnot_ps(b, a); } //! Note the order!
+	static unsigned bits(M m)        { return unsigned(_mm_movemask_ps(m)); }
+	static float hsum(F a) { alignas(16) float t[4]; _mm_store_ps(t, a); return t[0] + t[1] + t[2] + t[3]; }
+};
+#endif
+
+#ifdef _GK_NEON_
+//----------------------------------------------------------------------------
+struct NEONLanes
+{
+	static constexpr unsigned N = 4;
+	using F = float32x4_t;
+	using M = uint32x4_t;
+
+	static F load(const float* p)    { return vld1q_f32(p); }
+	static void store(float* p, F a) { vst1q_f32(p, a); }
+	static F set(float x)            { return vdupq_n_f32(x); }
+	static F add(F a, F b)           { return vaddq_f32(a, b); }
+	static F sub(F a, F b)           { return vsubq_f32(a, b); }
+	static F mul(F a, F b)           { return vmulq_f32(a, b); }
+	static F div(F a, F b)           { return vdivq_f32(a, b); }
+	static F sqrt(F a)               { return vsqrtq_f32(a); }
+	static F select(M m, F a)        { return vreinterpretq_f32_u32(vandq_u32(m, vreinterpretq_u32_f32(a))); }
+	static M le(F a, F b)            { return vcleq_f32(a, b); }
+	static M gt(F a, F b)            { return vcgtq_f32(a, b); }
+	static M and_(M a, M b)          { return vandq_u32(a, b); }
+	static M and_not(M a, M b)       { return vbicq_u32(a, b); }
+	static unsigned bits(M m)        { const uint32x4_t w = {1, 2, 4, 8}; return vaddvq_u32(vandq_u32(m, w)); }
+	static float hsum(F a)           { return vaddvq_f32(a); }
+};
+#endif
+
+#ifdef _GK_X86_
+//----------------------------------------------------------------------------
+bool cpu_has_avx()
+{
+# ifdef DISABLE_AVX_KERNEL
+	return false;
+# elif defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+	bool avx     = info[2] & (1 << 28);
+	bool osxsave = info[2] & (1 << 27);
+	return avx && osxsave && (_xgetbv(0) & 6) == 6; // Also the OS must save the YMM regs.!
+# else
+	return __builtin_cpu_supports("avx"); // Checks the OS support, too
+# endif
+}
+#endif
+
+} // namespace ----------------------------------------------------------------
+
+
+//----------------------------------------------------------------------------
+ISA best_available()
+{
+#if defined(_GK_X86_)
+	if (cpu_has_avx()) return ISA::AVX;
+# ifdef _GK_SSE2_
+	return ISA::SSE2;
+# endif
+#elif defined(_GK_NEON_)
+	return ISA::NEON;
+#endif
+	return ISA::Generic;
+}
+
+const char* name(ISA isa)
+{
+	switch (isa) {
+	case ISA::SSE2: return "SSE2";
+	case ISA::AVX:  return "AVX";
+	case ISA::NEON: return "NEON";
+	default:        return "generic";
+	}
+}
+
+//----------------------------------------------------------------------------
+void sweep(ISA isa, const Bodies& b, const Params& p, size_t source, size_t first, size_t last,
+           CollisionFn on_collision, void* ctx)
+{
+	switch (isa) {
+#if defined(_GK_X86_) && !defined(DISABLE_AVX_KERNEL)
+	case ISA::AVX:  first = impl::sweep_AVX(b, p, source, first, last, on_collision, ctx); break;
+#endif
+#ifdef _GK_SSE2_
+	case ISA::SSE2: first = impl::dispatch<SSE2Lanes>(b, p, source, first, last, on_collision, ctx); break;
+#endif
+#ifdef _GK_NEON_
+	case ISA::NEON: first = impl::dispatch<NEONLanes>(b, p, source, first, last, on_collision, ctx); break;
+#endif
+	default:        first = impl::dispatch<GenericLanes<8>>(b, p, source, first, last, on_collision, ctx); break;
+	}
+	// The rest (less than a full block):
+	impl::dispatch<GenericLanes<1>>(b, p, source, first, last, on_collision, ctx);
+}
+
+} // namespace Model::GravityKernel
+
+
+namespace Model {
+
+//============================================================================
+GravityKernel::Bodies World::_kernel_bodies()
+// Also refreshes the per-tick masks, so call it only once per tick!
+{
+	static std::vector<float> alive, pulled; // Static to reuse their buffers across ticks
+	auto obj_cnt = bodies.size();
+	alive.resize(obj_cnt);
+	pulled.resize(obj_cnt);
+	for (size_t i = 0; i < obj_cnt; ++i) {
+		alive[i]  = bodies.terminated(i) ? 0.f : 1.f;
+		pulled[i] = bodies.superpower[i].gravity_immunity ? 0.f : 1.f;
+	}
+
+#ifndef MODEL_DOUBLE
+	return {
+		.px = bodies.px.data(), .py = bodies.py.data(), .mass = bodies.mass.data(), .r = bodies.r.data(),
+		.vx = bodies.vx.data(), .vy = bodies.vy.data(),
+		.alive = alive.data(), .pulled = pulled.data(),
+		.count = obj_cnt,
+	};
+#else
+	// Mixed precision: the kernel is float-only, so it gets float copies, with
+	// the positions relative to the middle of the bodies (as the distances are
+	// still much better there than with the absolute coords.), and it sums the
+	// velocity changes into zeroed arrays, for _kernel_commit() to add them to
+	// the (double) velocities:
+	static std::vector<float> px, py, mass, r, dvx, dvy;
+	px.resize(obj_cnt); py.resize(obj_cnt); mass.resize(obj_cnt); r.resize(obj_cnt);
+	dvx.assign(obj_cnt, 0.f); dvy.assign(obj_cnt, 0.f);
+
+	NumType x_min = 0, x_max = 0, y_min = 0, y_max = 0;
+	for (size_t i = 0; i < obj_cnt; ++i) {
+		if (i == 0 || bodies.px[i] < x_min) x_min = bodies.px[i];
+		if (i == 0 || bodies.px[i] > x_max) x_max = bodies.px[i];
+		if (i == 0 || bodies.py[i] < y_min) y_min = bodies.py[i];
+		if (i == 0 || bodies.py[i] > y_max) y_max = bodies.py[i];
+	}
+	const NumType cx = (x_min + x_max) / 2, cy = (y_min + y_max) / 2;
+	for (size_t i = 0; i < obj_cnt; ++i) {
+		px[i] = float(bodies.px[i] - cx);
+		py[i] = float(bodies.py[i] - cy);
+		mass[i] = float(bodies.mass[i]);
+		r[i] = float(bodies.r[i]);
+	}
+
+	return {
+		.px = px.data(), .py = py.data(), .mass = mass.data(), .r = r.data(),
+		.vx = dvx.data(), .vy = dvy.data(),
+		.alive = alive.data(), .pulled = pulled.data(),
+		.count = obj_cnt,
+	};
+#endif
+}
+
+//----------------------------------------------------------------------------
+void World::_kernel_commit([[maybe_unused]] const GravityKernel::Bodies& b)
+// Apply the velocity changes, if the kernel didn't write them directly
+// (see _kernel_bodies())
+{
+#ifdef MODEL_DOUBLE
+	for (size_t i = 0; i < b.count; ++i) {
+		bodies.vx[i] += b.vx[i];
+		bodies.vy[i] += b.vy[i];
+	}
+#endif
+}
+
+//----------------------------------------------------------------------------
+GravityKernel::Params World::_kernel_params(float dt) const
+{
+	using namespace GravityKernel;
+	using enum GravityMode;
+
+#ifndef DISABLE_FULL_INTERACTION_LOOP
+	const bool half = loop_mode != LoopMode::Full;
+#else
+	const bool half = true;
+#endif
+	return {
+		.G = float(gravity), .dt = dt,
+		.law = gravity_mode == Hyperbolic ? Law::Hyperbolic
+		     : gravity_mode == Realistic || (gravity_mode == Experimental && !half) ? Law::Realistic
+		     : Law::None, // Like the Half loop, which has no gravity in Experimental mode
+		.half = half,
+	};
+}
+
+//----------------------------------------------------------------------------
+GravityKernel::ISA World::_kernel_isa() const
+{
+	static const auto best = [] {
+		auto isa = GravityKernel::best_available();
+		cerr << "- Using the " << GravityKernel::name(isa) << " gravity kernel.\n";
+		return isa;
+	}();
+	return simd ? best : GravityKernel::ISA::Generic;
+}
+
+//----------------------------------------------------------------------------
+void World::update_pairwise_interactions_SIMD(float dt, Szim::SimApp& app)
+// Same as the exact loop (see update_pairwise_interactions), with the SIMD kernel
+// doing the inner (target) loop.
+{
+ZoneScoped;
+	using namespace GravityKernel;
+
+	const auto isa = _kernel_isa();
+	const auto b = _kernel_bodies();
+	const auto p = _kernel_params(dt);
+	auto obj_cnt = b.count;
+
+	struct Ctx { World* world; Szim::SimApp* app; } ctx = {this, &app};
+	CollisionFn on_collision = broadphase ? nullptr // Already done
+	: +[](void* c, size_t target, size_t source, float distance) {
+		auto& [world, app] = *(Ctx*)c;
+		world->_collide(target, source, distance, *app);
+	};
+
+	for (size_t source = 0; source < (_interact_all ? obj_cnt : 1); ++source)
+	{
+		if (bodies.terminated(source)) continue;
+
+		if (p.half) {
+			sweep(isa, b, p, source, source + 1, obj_cnt, on_collision, &ctx);
+		} else {
+			sweep(isa, b, p, source, 0, source, on_collision, &ctx);
+			sweep(isa, b, p, source, source + 1, obj_cnt, on_collision, &ctx);
+		}
+	}
+	_kernel_commit(b);
+}
+
+//----------------------------------------------------------------------------
+void World::update_pairwise_interactions_heavy(float dt, Szim::SimApp& app)
+// Only the massive bodies (at least source_mass_ratio times as heavy as the
+// heaviest one) pull the others, so it's O(n·m) for m such "sources"; the rest
+// are treated as test particles: they're still pulled by the sources, but not
+// by each other, and they don't pull back either.
+//
+// Each source sweeps all the bodies with the kernel (in Full mode, i.e. with
+// the "proper" force laws, like in BarnesHut.cpp), so the sources are also
+// pulled by each other, as targets.
+//
+// The collisions are all found by the broadphase (see SpatialHash.cpp) here,
+// as most of the pairs are never even looked at.
+{
+ZoneScoped;
+	using namespace GravityKernel;
+
+	if (!broadphase) update_collisions_broadphase(app); // Already done otherwise
+
+	// Not bit-exact with any of the other loops anyway, so always the fastest kernel:
+	static const auto isa = best_available();
+	const auto b = _kernel_bodies();
+	auto p = _kernel_params(dt);
+	p.half = false;
+	p.law = gravity_mode == GravityMode::Hyperbolic ? Law::Hyperbolic : Law::Realistic; // (Also for Experimental)
+	const auto obj_cnt = b.count;
+
+	// Classify...
+	static std::vector<size_t> sources; // Static to reuse its buffer across ticks
+	sources.clear();
+	NumType m_max = 0;
+	for (size_t i = 0; i < obj_cnt; ++i)
+		if (!bodies.terminated(i)) m_max = std::max(m_max, bodies.mass[i]);
+	for (size_t i = 0; i < obj_cnt; ++i)
+		if (!bodies.terminated(i) && bodies.mass[i] >= m_max * source_mass_ratio) sources.push_back(i);
+
+	// ...and pull. Each target is only written by its own sweep, so it can be
+	// split up by target ranges (and it's deterministic, too: the sources are
+	// always summed in the same order for a target):
+	auto pull_range = [&](size_t first, size_t last) {
+		for (auto s : sources) {
+			if (s < first || s >= last) {
+				sweep(isa, b, p, s, first, last, nullptr, nullptr);
+			} else { // The source itself must be left out
+				sweep(isa, b, p, s, first, s, nullptr, nullptr);
+				sweep(isa, b, p, s, s + 1, last, nullptr, nullptr);
+			}
+		}
+	};
+
+	static constexpr size_t MT_MIN_WORK = 100000; // sources * targets
+	if (threads != 1 && sources.size() * obj_cnt >= MT_MIN_WORK) {
+		app.jobs.parallel_for("heavy source gravity", obj_cnt, 1024, pull_range, threads);
+	} else {
+		pull_range(0, obj_cnt);
+	}
+	_kernel_commit(b);
+}
+
+} // namespace Model
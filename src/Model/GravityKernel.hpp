@@ -0,0 +1,71 @@
+#ifndef _GK0W5T2MQ83HXN6Z1CV7RB49YDJ4LFP8_
+#define _GK0W5T2MQ83HXN6Z1CV7RB49YDJ4LFP8_
+
+//============================================================================
+// SIMD kernel for the exact O(n²) gravity + collision loop
+//
+// Takes one "source" body and sweeps a range of "target" bodies with it,
+// several targets at once, doing the same per-pair calculations as the
+// (scalar) reference loop in World.cpp.
+//
+// The per-pair results are bit-exact with the scalar loop (IEEE div & sqrt are
+// correctly rounded in the vector units, too), only the summation order of the
+// reaction on the source differs in Half mode, where it gets added in one go
+// for each sweep. (So the regression tests still need the scalar loop...)
+//
+// Collisions are detected in the kernel, but then handed back to the caller
+// one by one (in the index order of the targets), as before.
+//
+// The instruction set is selected at runtime (see best_available()), so the
+// binary doesn't need to be built with AVX enabled to use it.
+//
+//! Only for float (the double build of the model feeds it float copies, see
+//! World::_kernel_bodies())!
+//============================================================================
+
+#include <cstddef> // size_t
+
+namespace Model::GravityKernel {
+
+	enum class ISA : unsigned { Generic, SSE2, AVX, NEON };
+
+	ISA best_available(); // The widest one the CPU (and the build) supports
+	const char* name(ISA isa);
+
+	enum class Law : unsigned { None, Hyperbolic, Realistic };
+
+	//! The arrays of the World::BodyStore, plus two per-tick masks (1 or 0, as
+	//! float, for easy blending), so the kernel doesn't need to know about Body:
+	struct Bodies
+	{
+		const float* px;
+		const float* py;
+		const float* mass;
+		const float* r;
+		float* vx;
+		float* vy;
+		size_t v_first = 0;  // vx[0], vy[0] belong to this body (for partial accumulators, see World_MT.cpp)
+		const float* alive;  // 0 for terminated bodies
+		const float* pulled; // 0 for gravity_immunity
+		size_t count;
+	};
+
+	struct Params
+	{
+		float G;
+		float dt;
+		Law   law;
+		bool  half; // Half mode: also apply the reaction on the source
+	};
+
+	// Called for each colliding (live) target, in index order (if not null):
+	using CollisionFn = void (*)(void* ctx, size_t target, size_t source, float distance);
+
+	// Interact `source` with each (live) target in [first, last).
+	//! The source itself must not be in the range!
+	void sweep(ISA isa, const Bodies& b, const Params& p, size_t source, size_t first, size_t last,
+	           CollisionFn on_collision, void* ctx);
+
+} // namespace Model::GravityKernel
+
+#endif // _GK0W5T2MQ83HXN6Z1CV7RB49YDJ4LFP8_
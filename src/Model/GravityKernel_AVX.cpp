@@ -0,0 +1,74 @@
+//! This file is compiled for AVX (see the pragmas below), regardless of the
+//! build options, so nothing in here must run on a CPU without it. It's only
+//! called after checking the CPU (see GravityKernel::best_available()).
+//!
+//! Also, nothing inline from the std. lib. may be used here, as the linker
+//! could then pick the AVX instance of it for the rest of the program, too! :-o
+
+#include "Model/GravityKernel.hpp"
+
+#if (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)) && !defined(DISABLE_AVX_KERNEL)
+
+#if defined(__clang__)
+# pragma clang attribute push (__attribute__((target("avx"))), apply_to = function)
+#elif defined(__GNUC__)
+# pragma GCC push_options
+# pragma GCC target("avx")
+#endif
+//! MSVC doesn't need anything for the intrinsics (only /arch:AVX would let it
+//! generate AVX code on its own, which is not what we want here anyway).
+
+#include <immintrin.h>
+#include "Model/GravityKernel_impl.hpp" //! After the pragmas, for the templates to be compiled for AVX, too!
+
+
+namespace Model::GravityKernel {
+
+namespace { //----------------------------------------------------------------
+
+struct AVXLanes
+{
+	static constexpr unsigned N = 8;
+	using F = __m256;
+	using M = __m256;
+
+	static F load(const float* p)    { return _mm256_loadu_ps(p); }
+	static void store(float* p, F a) { _mm256_storeu_ps(p, a); }
+	static F set(float x)            { return _mm256_set1_ps(x); }
+	static F add(F a, F b)           { return _mm256_add_ps(a, b); }
+	static F sub(F a, F b)           { return _mm256_sub_ps(a, b); }
+	static F mul(F a, F b)           { return _mm256_mul_ps(a, b); }
+	static F div(F a, F b)           { return _mm256_div_ps(a, b); }
+	static F sqrt(F a)               { return _mm256_sqrt_ps(a); }
+	static F select(M m, F a)        { return _mm256_and_ps(m, a); }
+	static M le(F a, F b)            { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+	static M gt(F a, F b)            { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	static M and_(M a, M b)          { return _mm256_and_ps(a, b); }
+	static M and_not(M a, M b)       { return _mm256_andnot_ps(b, a); } //! Note the order!
+	static unsigned bits(M m)        { return unsigned(_mm256_movemask_ps(m)); }
+	static float hsum(F a) {
+		__m128 s = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+		s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+		s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+		return _mm_cvtss_f32(s);
+	}
+};
+
+} // namespace ----------------------------------------------------------------
+
+
+size_t impl::sweep_AVX(const Bodies& b, const Params& p, size_t s, size_t first, size_t last,
+                       CollisionFn on_collision, void* ctx)
+{
+	return dispatch<AVXLanes>(b, p, s, first, last, on_collision, ctx);
+}
+
+} // namespace Model::GravityKernel
+
+#if defined(__clang__)
+# pragma clang attribute pop
+#elif defined(__GNUC__)
+# pragma GCC pop_options
+#endif
+
+#endif // x86 && !DISABLE_AVX_KERNEL
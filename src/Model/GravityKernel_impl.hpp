@@ -0,0 +1,129 @@
+#ifndef _GKI3N8R0WQ5TZ2M7XC49VB1HY6DJ0LKE_
+#define _GKI3N8R0WQ5TZ2M7XC49VB1HY6DJ0LKE_
+
+//! Internal to the GravityKernel*.cpp files! (The ISA-specific ones are compiled
+//! with different target options, so nothing here may be shared between them
+//! via the linker: everything is either a template or in an anon. namespace.)
+
+#include "Model/GravityKernel.hpp"
+
+namespace Model::GravityKernel::impl {
+
+//----------------------------------------------------------------------------
+// The lane types (V) must provide (all static):
+//
+//   N, F (float lanes), M (mask lanes),
+//   load, store, set, add, sub, mul, div, sqrt,
+//   le, gt (-> M), and_, and_not (a & ~b), select (m ? a : 0),
+//   bits (M -> lane bitmask), hsum (horizontal sum)
+//
+// The calculations (and their order!) follow the scalar loop in World.cpp.
+//
+// Returns the first target not processed (when less than N are left).
+//
+//! NOTE: The hooks called for the collisions may change the bodies, but the
+//!       positions and radii of the current block have already been loaded by
+//!       then. (The velocities are only loaded after the hooks, though.)
+//
+template <class V, Law LAW, bool HALF>
+size_t sweep(const Bodies& b, const Params& p, size_t s, size_t t, size_t last,
+             CollisionFn on_collision, void* ctx)
+{
+	using F = typename V::F;
+
+	const F zero = V::set(0.f);
+	const F sx = V::set(b.px[s]), sy = V::set(b.py[s]), sr = V::set(b.r[s]);
+	const F G = V::set(p.G), dt = V::set(p.dt);
+	const F Gm_s = V::set(p.G * b.mass[s]); // Full mode
+	const F m_s = V::set(b.mass[s]);        // Half mode
+	F react_x = zero, react_y = zero;       // Half mode: the (negated) pull on the source
+
+	for (; t + V::N <= last; t += V::N)
+	{
+		auto dx = V::sub(sx, V::load(b.px + t)),
+		     dy = V::sub(sy, V::load(b.py + t));
+		auto distance = V::sqrt(V::add(V::mul(dx, dx), V::mul(dy, dy)));
+
+		auto alive = V::gt(V::load(b.alive + t), zero);
+		auto colliding = V::and_(alive, V::le(distance, V::add(sr, V::load(b.r + t))));
+
+		if (unsigned hits = V::bits(colliding); hits && on_collision) {
+			alignas(32) float d[V::N];
+			V::store(d, distance);
+			for (unsigned l = 0; l < V::N; ++l)
+				if (hits & (1u << l)) on_collision(ctx, t + l, s, d[l]);
+		}
+
+		if constexpr (LAW == Law::None) continue;
+		else {
+			auto pulling = V::and_not(alive, colliding);
+			auto pulled = V::and_(pulling, V::gt(V::load(b.pulled + t), zero));
+			F dvx, dvy;
+
+			if constexpr (HALF) {
+				auto G_dt_div_d2 = V::mul(V::div(G, V::mul(distance, distance)), dt);
+				auto a = V::mul(G_dt_div_d2, m_s);
+				dvx = V::mul(dx, a);
+				dvy = V::mul(dy, a);
+				auto a_s = V::mul(G_dt_div_d2, V::load(b.mass + t));
+				auto rx = V::mul(dx, a_s),
+				     ry = V::mul(dy, a_s);
+				if constexpr (LAW == Law::Realistic) {
+					auto dt_div_d = V::div(dt, distance);
+					dvx = V::mul(dvx, dt_div_d); dvy = V::mul(dvy, dt_div_d);
+					rx = V::mul(rx, dt_div_d); ry = V::mul(ry, dt_div_d);
+				}
+				react_x = V::add(react_x, V::select(pulling, rx));
+				react_y = V::add(react_y, V::select(pulling, ry));
+			} else {
+				auto a = V::div(Gm_s, V::mul(distance, distance));
+				dvx = V::mul(dx, a);
+				dvy = V::mul(dy, a);
+				auto f = LAW == Law::Realistic ? V::div(dt, distance) : dt;
+				dvx = V::mul(dvx, f); dvy = V::mul(dvy, f);
+			}
+
+			auto vx = b.vx + (t - b.v_first), vy = b.vy + (t - b.v_first);
+			V::store(vx, V::add(V::load(vx), V::select(pulled, dvx)));
+			V::store(vy, V::add(V::load(vy), V::select(pulled, dvy)));
+		}
+	}
+
+	if constexpr (HALF && LAW != Law::None) {
+		if (b.pulled[s] > 0) {
+			b.vx[s - b.v_first] -= V::hsum(react_x);
+			b.vy[s - b.v_first] -= V::hsum(react_y);
+		}
+	}
+
+	return t;
+}
+
+//----------------------------------------------------------------------------
+// Dispatch on the runtime params to the right instance, for one lane type.
+//
+template <class V>
+size_t dispatch(const Bodies& b, const Params& p, size_t s, size_t first, size_t last,
+                CollisionFn on_collision, void* ctx)
+{
+	switch (p.law) {
+	case Law::Hyperbolic:
+		return p.half ? sweep<V, Law::Hyperbolic, true>(b, p, s, first, last, on_collision, ctx)
+		              : sweep<V, Law::Hyperbolic, false>(b, p, s, first, last, on_collision, ctx);
+	case Law::Realistic:
+		return p.half ? sweep<V, Law::Realistic, true>(b, p, s, first, last, on_collision, ctx)
+		              : sweep<V, Law::Realistic, false>(b, p, s, first, last, on_collision, ctx);
+	default:
+		return sweep<V, Law::None, false>(b, p, s, first, last, on_collision, ctx);
+	}
+}
+
+//----------------------------------------------------------------------------
+// The AVX instances live in their own TU (GravityKernel_AVX.cpp), as that's
+// compiled for AVX, so calling it is only safe if the CPU has it:
+size_t sweep_AVX(const Bodies& b, const Params& p, size_t s, size_t first, size_t last,
+                 CollisionFn on_collision, void* ctx);
+
+} // namespace Model::GravityKernel::impl
+
+#endif // _GKI3N8R0WQ5TZ2M7XC49VB1HY6DJ0LKE_
@@ -25,7 +25,9 @@
 	//!! SHOULD BE MADE IMPLICIT & COMPILE-TIME-ONLY!
 
 
-#include <cmath> // pow, sqrt
+#include <cmath> // pow, sqrt, cbrt
+#include <bit> // bit_cast
+#include <cstdint> // uint32_t
 
 namespace Math {
 
@@ -47,6 +49,21 @@ template <typename T> inline T power(T base, T exp) {}
 	template <> inline double      power<double>(double base, double exp) { return pow(base, exp); }
 	template <> inline long double power<long double>(long double base, long double exp) { return powl(base, exp); }
 
+// Cube root, for the radius from the volume, w/o the generic pow():
+//! Not bit-exact with power(x, 1/3) (which isn't even quite the cube root for
+//! float, as 1/3 isn't exact), so it's only used with MODEL_FAST_CBRT (see cfg.h)!
+template <typename T> inline T cbrt_fast(T x) { return std::cbrt(x); }
+	template <> inline float cbrt_fast<float>(float x) {
+		if (!(x > 0)) return std::cbrt(x); // 0, negative, NaN: not worth it
+		// Rough guess (~5%) from the exponent (x/3)...
+		auto y = double(std::bit_cast<float>(std::bit_cast<uint32_t>(x) / 3 + 0x2a514067u));
+		// ...then two Halley steps (each ~triples the correct digits), in double, to round well:
+		const auto xd = double(x);
+		y *= (y*y*y + 2*xd) / (2*y*y*y + xd);
+		y *= (y*y*y + 2*xd) / (2*y*y*y + xd);
+		return float(y);
+	}
+
 
 //!! There might also be a need for a "fast" version (like mag2_sq) that's only used
 //!! to sort/select/differentiate objects by distance, so the sqrt can be skipped!
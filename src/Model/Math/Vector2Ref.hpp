@@ -0,0 +1,45 @@
+#ifndef _V2R5KX90M3T7BQ1C48WN62YHF0DJ9ZE4_
+#define _V2R5KX90M3T7BQ1C48WN62YHF0DJ9ZE4_
+
+//! NOTE: Not one of the SFML rip-offs here, but a companion of them for the
+//! SoA entity storage of the model, where the x and y coordinates of the
+//! vectors live in separate arrays.
+
+#include "Vector2.hpp"
+
+namespace Math
+{
+
+//----------------------------------------------------------------------------
+// A vector "view" of an (x, y) pair of variables stored separately.
+// Assignments go through to the referenced variables (it can't be rebound).
+//
+template <typename T>
+struct Vector2Ref
+{
+	T& x;
+	T& y;
+
+	Vector2Ref(T& x_, T& y_) : x(x_), y(y_) {}
+	Vector2Ref(const Vector2Ref&) = default;
+
+	Vector2<T> get() const { return {x, y}; }
+	template <typename U> operator Vector2<U>() const { return Vector2<U>(U(x), U(y)); }
+
+	Vector2Ref& operator=(const Vector2<T>& v) { x = v.x; y = v.y; return *this; }
+	Vector2Ref& operator=(const Vector2Ref& r) { x = r.x; y = r.y; return *this; } //! Copies the values, not the refs!
+	Vector2Ref& operator+=(const Vector2<T>& v) { x += v.x; y += v.y; return *this; }
+	Vector2Ref& operator-=(const Vector2<T>& v) { x -= v.x; y -= v.y; return *this; }
+
+	bool operator==(const Vector2<T>& v) const { return x == v.x && y == v.y; }
+
+	Vector2<T> operator*(T factor) const { return {x * factor, y * factor}; }
+	Vector2<T> operator/(T divisor) const { return {x / divisor, y / divisor}; }
+
+	T length() const { return get().length(); }
+	[[nodiscard]] Vector2<T> normalized() const { return get().normalized(); }
+};
+
+} // namespace Math
+
+#endif // _V2R5KX90M3T7BQ1C48WN62YHF0DJ9ZE4_
@@ -16,7 +16,7 @@ void World::Body::recalc()
 //	mass = powf(r, 3) * density;
 	r = Phys::radius_from_mass_and_density(mass, density);
 //	Phys::BV_to_T_and_RGB(Phys::T_to_BV(T), superpower.free_color ? nullptr : &color);
-	Phys::T_to_RGB_and_BV(T, superpower.free_color ? nullptr : &color);
+	if (!superpower.free_color) Phys::T_to_RGB(T, &color);
 }
 
 //----------------------------------------------------------------------------
@@ -25,4 +25,42 @@ void World::Body::on_event(Event e, ...)
 	r *= 0.1f; //!!Just to see if it works at all!...
 }
 
+
+//============================================================================
+void World::BodyRef::recalc()
+// Same as Body::recalc(), but only redoing what's changed since the last time
+// (e.g. OONApp::touch_hook() calls this for every touching pair in every tick,
+// only changing T)
+{
+	auto& c = recalced;
+
+	if (!(c.r_valid && mass == c.mass && density == c.density && r == c.r)) {
+		r = Phys::radius_from_mass_and_density(mass, density);
+		c.mass = mass; c.density = density; c.r = r;
+		c.r_valid = true;
+	}
+
+	if (!superpower.free_color && !(c.color_valid && T == c.T && color == c.color)) {
+		Phys::T_to_RGB(T, &color); // (Leaves it as is below T_BV_MIN, so the result is still just up to T and c.color)
+		c.T = T; c.color = color;
+		c.color_valid = true;
+	}
+}
+
+//----------------------------------------------------------------------------
+void World::BodyRef::on_event(Event e, ...)
+{
+	r *= 0.1f; //!!Just to see if it works at all!...
+}
+
+//----------------------------------------------------------------------------
+World::BodyRef::operator Body() const
+{
+	Body copy{ .superpower = superpower, .lifetime = lifetime, .r = r, .density = density,
+	           .p = p.get(), .v = v.get(), .T = T, .color = color, .mass = mass,
+	           .thrust_up = thrust_up, .thrust_down = thrust_down,
+	           .thrust_left = thrust_left, .thrust_right = thrust_right };
+	return copy;
+}
+
 } // namespace Model
@@ -10,6 +10,7 @@
 	using std::string;
 //#include <cstddef>
 //	using std::byte; //!!No use: ofstream can't write() bytes! :-o Congratulations, C++!... :-/
+#include <cstring> // memcpy
 #include <cassert>
 #include <iostream>
 	using std::cerr, std::endl;
@@ -17,6 +18,23 @@
 
 namespace Model {
 
+#ifdef MODEL_DOUBLE
+namespace {
+	// Body, as laid out by the (default) float build, so that its snapshots
+	// (e.g. the start states of the regression tests) can be loaded, too:
+	struct Body_float
+	{
+		struct { bool gravity_immunity, free_color; } superpower;
+		float lifetime, r, density;
+		Math::Vector2<float> p, v;
+		float T;
+		uint32_t color;
+		float mass;
+		Thruster thrust_up, thrust_down, thrust_left, thrust_right;
+	};
+}
+#endif
+
 //static constexpr char BSIG[] = {'O','B','0','1'};
 //----------------------------------------------------------------------------
 bool World::Body::save(std::ostream& out)
@@ -62,6 +80,20 @@ bool World::Body::save(std::ostream& out)
 		//! reallocation per every few dozen objects, BTW.
 //cerr << "["<<ndx<<"]" << c <<" \""<< objdump << "\"" << endl;
 
+#ifdef MODEL_DOUBLE
+	if (objdump.size() == sizeof(Body_float)) { // Saved by a float build
+		Body_float f;
+		memcpy((void*)&f, objdump.data(), sizeof(f));
+		*result = {
+			.superpower = { .gravity_immunity = f.superpower.gravity_immunity, .free_color = f.superpower.free_color },
+			.lifetime = f.lifetime, .r = f.r, .density = f.density,
+			.p = { f.p.x, f.p.y }, .v = { f.v.x, f.v.y },
+			.T = f.T, .color = f.color, .mass = f.mass,
+			.thrust_up = f.thrust_up, .thrust_down = f.thrust_down, .thrust_left = f.thrust_left, .thrust_right = f.thrust_right,
+		};
+		return true;
+	}
+#endif
 	if (sizeof(Body) != objdump.size()) {
 		cerr << "- ERROR: Failed to load object! Bytes expected: " << sizeof(Body) << ", found: " << objdump.size() <<".\n";
 		return false;
@@ -0,0 +1,118 @@
+// Must do this first for Tracy's winsock2.h has to precede any windows.h! :-/
+#include "extern/Tracy/public/tracy/Tracy.hpp"
+
+#include "Model/ParticlePool.hpp"
+#include "Model/World.hpp"
+
+#include <cmath> // sqrt
+#include <algorithm> // max
+
+
+namespace Model {
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+void ParticlePool::set_capacity(size_t n)
+{
+	_capacity = n;
+	clear();
+	for (auto* a : {&px, &py, &vx, &vy, &r}) a->reserve(n);
+	age.reserve(n);
+	lifetime.reserve(n);
+	color.reserve(n);
+}
+
+//----------------------------------------------------------------------------
+void ParticlePool::clear()
+{
+	for (auto* a : {&px, &py, &vx, &vy, &r}) a->clear();
+	age.clear();
+	lifetime.clear();
+	color.clear();
+	_next = 0;
+	_live = 0;
+}
+
+//----------------------------------------------------------------------------
+void ParticlePool::emit(NumType x, NumType y, NumType v_x, NumType v_y, NumType radius, float life, uint32_t rgb)
+{
+	if (!_capacity) return;
+
+	if (size() < _capacity) { // Still filling up
+		px.push_back(x); py.push_back(y);
+		vx.push_back(v_x); vy.push_back(v_y);
+		r.push_back(radius);
+		age.push_back(0);
+		lifetime.push_back(life);
+		color.push_back(rgb);
+		++_live;
+	} else { // Recycle the oldest
+		if (!alive(_next)) ++_live;
+		px[_next] = x; py[_next] = y;
+		vx[_next] = v_x; vy[_next] = v_y;
+		r[_next] = radius;
+		age[_next] = 0;
+		lifetime[_next] = life;
+		color[_next] = rgb;
+	}
+	_next = (_next + 1) % _capacity;
+}
+
+//----------------------------------------------------------------------------
+void ParticlePool::update(float dt, const World& world)
+{
+ZoneScoped;
+	if (dt == 0.f || px.empty()) return;
+
+	const auto& bodies = world.bodies;
+	const auto n = size();
+
+	// Collect the pulling bodies (once per tick, they don't move meanwhile)...
+	_sources.clear();
+	if (gravity && world.gravity_mode != World::GravityMode::Off) {
+		NumType m_max = 0;
+		for (size_t b = 0; b < bodies.size(); ++b)
+			if (!bodies.terminated(b)) m_max = max(m_max, bodies.mass[b]);
+		for (size_t b = 0; b < bodies.size(); ++b)
+			if (!bodies.terminated(b) && bodies.mass[b] >= m_max * source_mass_ratio) _sources.push_back(b);
+	}
+	const bool realistic = world.gravity_mode != World::GravityMode::Hyperbolic; // Like in BarnesHut.cpp
+
+	_live = 0;
+	for (size_t i = 0; i < n; ++i)
+	{
+		if (!alive(i)) continue;
+
+		// Fall (with the "proper" force laws of the Full loop)...
+		for (auto s : _sources) {
+			auto dx = bodies.px[s] - px[i],
+			     dy = bodies.py[s] - py[i];
+			auto distance = Math::mag2(dx, dy);
+			if (distance <= bodies.r[s]) { // Hit it: gone
+				lifetime[i] = 0; age[i] = 0;
+				break;
+			}
+			auto a = world.gravity * bodies.mass[s] / (distance * distance);
+			auto f = realistic ? NumType(dt) / distance : NumType(dt);
+			vx[i] += dx * a * f;
+			vy[i] += dy * a * f;
+		}
+		if (!alive(i)) continue;
+
+		// ...drift, with the same drag as the bodies...
+		vx[i] -= vx[i] * NumType(world.friction) * NumType(dt);
+		vy[i] -= vy[i] * NumType(world.friction) * NumType(dt);
+		px[i] += vx[i] * NumType(dt);
+		py[i] += vy[i] * NumType(dt);
+
+		// ...and decay:
+		if (lifetime[i] != Model::Unlimited) {
+			age[i] += dt;
+			if (!alive(i)) continue;
+		}
+		++_live;
+	}
+}
+
+} // namespace Model
@@ -0,0 +1,71 @@
+#ifndef _PP3K8QZ1VN6WY0MT4RX72DJ5BHC9LSG6_
+#define _PP3K8QZ1VN6WY0MT4RX72DJ5BHC9LSG6_
+
+#include "Engine/Model.hpp" // Unlimited
+#include "Model/Physics.hpp"
+
+#include <vector>
+#include <cstdint>
+
+namespace Model {
+
+class World;
+
+//============================================================================
+// Light-weight particles for the short-lived emitter effects (exhaust plumes,
+// chemtrails, shield...)
+//
+// Unlike World::Body, these have no mass, thrusters, superpowers etc., don't
+// collide, and don't pull anything, so they don't take part in the pairwise
+// interactions at all: they just drift, optionally feeling the gravity of the
+// massive bodies of the world (the heaviest ones, see source_mass_ratio), so
+// the cost is O(particles * sources), not O((particles + bodies)²).
+//
+// Fixed capacity ring: when full, the oldest ones get overwritten. The slots
+// of the expired ones are not reused before that, they're just skipped (see
+// alive()).
+//
+//! Not part of the world state: not saved, and the indexes are not stable
+//! (unlike the bodies, nothing refers to them anyway).
+//
+class ParticlePool
+{
+public:
+	using NumType = Phys::NumType;
+
+	static constexpr size_t DEFAULT_CAPACITY = 10000;
+
+	// SoA, like World::BodyStore:
+	std::vector<NumType> px, py, vx, vy;
+	std::vector<NumType> r;
+	std::vector<float> age, lifetime; // lifetime: Model::Unlimited, or s; expired: age >= lifetime
+	std::vector<uint32_t> color; // 0xRRGGBB
+
+	bool gravity = true; // Pulled by the massive bodies of the world (but not by each other)
+	NumType source_mass_ratio = 0.01f; // "Massive": at least this heavy, relative to the heaviest body
+
+	ParticlePool(size_t capacity = DEFAULT_CAPACITY) { set_capacity(capacity); }
+
+	void set_capacity(size_t n); //! Also clears the pool!
+	size_t capacity() const { return _capacity; }
+	size_t size() const { return px.size(); } // Slots used so far (live or expired), <= capacity()
+	size_t live() const { return _live; } // As of the last update() (or emit())
+
+	bool alive(size_t i) const { return lifetime[i] == Model::Unlimited || age[i] < lifetime[i]; }
+
+	void clear();
+	void emit(NumType x, NumType y, NumType vx, NumType vy, NumType r, float lifetime, uint32_t color);
+
+	// Drift (+ fall), age, and expire the ones hitting a (massive) body:
+	void update(float dt, const World& world);
+
+protected:
+	size_t _capacity = 0;
+	size_t _next = 0; // The slot to write next (the oldest one, once full)
+	size_t _live = 0;
+	std::vector<size_t> _sources; // Temp. for update()
+};
+
+} // namespace Model
+
+#endif // _PP3K8QZ1VN6WY0MT4RX72DJ5BHC9LSG6_
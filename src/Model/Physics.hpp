@@ -7,6 +7,9 @@
 #include "Math/Vector2.hpp"
 
 #include <cstdint> // uint32_t for colors... --> Physics/Color.hpp!!
+#include <vector> // T_to_RGB() LUT
+#include <cmath> // nextafter
+#include <algorithm> // min, max
 
 namespace Model {
 
@@ -63,16 +66,25 @@ public:
 	constexpr     static Mass mass_from_radius_and_density(Length r, Density d)
 	                               { return Mass(Math::FOUR_THIRD_PI<NumType>)* r*r*r * d; }
 	/*constexpr*/ static Length radius_from_mass_and_density(Mass m, Density d)
+#ifndef MODEL_FAST_CBRT
 	                               { return Length(Math::power(m/d/NumType(Math::FOUR_THIRD_PI<NumType>), NumType(1)/NumType(3))); } //!! cmath's pow() is not constepxr! :-o
+#else
+	                               { return Length(Math::cbrt_fast(m/d/NumType(Math::FOUR_THIRD_PI<NumType>))); }
+#endif
 //!!Should be this, but test:          { return Length(Math::power(m/d/Math::FOUR_THIRD_PI<NumType>, NumType(1)/NumType(3))); } //!! cmath's pow() is not constepxr! :-o
 
 	// Temp. -> color conversion
 	// OK, but now just this quick-and-dirty impromptu hack, instead of all the above... ;)
 	static inline NumType T_to_RGB_and_BV(Temperature T, uint32_t* p_color = nullptr);
+	// The same color (exactly), just via a lookup table (and without the BV):
+	static inline void T_to_RGB(Temperature T, uint32_t* p_color);
 
 private:
 	static constexpr auto T_BV_MIN = Temperature(15000);
 	static constexpr auto T_BV_MAX = Temperature(200000);
+
+	static constexpr unsigned T_LUT_STEP = 64; // K
+	static constexpr uint32_t T_LUT_MIXED = ~0u; // Not the same color all over the range (not RGB, as that's only 24 bits)
 };
 
 } // namespace Model
@@ -135,6 +147,36 @@ template <typename NumType> NumType Physics<NumType>::T_to_RGB_and_BV(Temperatur
 	return bv;
 }
 
+template <typename NumType> void Physics<NumType>::T_to_RGB(Temperature T, uint32_t* p_color)
+// The table has the color for each T_LUT_STEP wide range of T, if it's the same
+// for the whole range (i.e. at both ends, as the channels are monotonic between
+// the breaks of T_to_RGB_and_BV()), or T_LUT_MIXED, in which case it's just
+// calculated directly. (With the default step that's about 1/6 of the ranges.)
+//
+//! Not constexpr, but built on first use, by T_to_RGB_and_BV() itself, so it
+//! can't be off by a rounding error or so from that. (The regression tests
+//! would notice, as the colors are saved, too.)
+{
+	if (T < T_BV_MIN) return; // Leave the color, like T_to_RGB_and_BV()
+	if (!(T <= T_BV_MAX)) { *p_color = 0; return; } // Also for NaN, like T_to_RGB_and_BV()
+
+	static const auto lut = [] {
+		std::vector<uint32_t> table(unsigned(T_BV_MAX) / T_LUT_STEP + 1, T_LUT_MIXED);
+		for (unsigned i = unsigned(T_BV_MIN) / T_LUT_STEP; i < table.size(); ++i) {
+			auto lo = std::max(Temperature(i * T_LUT_STEP), T_BV_MIN),
+			     hi = std::min(std::nextafter(Temperature((i + 1) * T_LUT_STEP), Temperature(0)), T_BV_MAX);
+			uint32_t c_lo, c_hi;
+			T_to_RGB_and_BV(lo, &c_lo);
+			T_to_RGB_and_BV(hi, &c_hi);
+			if (c_lo == c_hi) table[i] = c_lo;
+		}
+		return table;
+	}();
+
+	if (auto c = lut[unsigned(T) / T_LUT_STEP]; c != T_LUT_MIXED) *p_color = c;
+	else T_to_RGB_and_BV(T, p_color);
+}
+
 
 } // namespace Model
 
@@ -0,0 +1,153 @@
+// Must do this first for Tracy's winsock2.h has to precede any windows.h! :-/
+#include "extern/Tracy/public/tracy/Tracy.hpp"
+
+#include "Model/SpatialHash.hpp"
+
+#include "Engine/SimApp.hpp" // The interaction hooks
+
+#include <cmath> // floor
+#include <algorithm> // max, sort
+
+
+namespace Model {
+
+using namespace std;
+
+//----------------------------------------------------------------------------
+int64_t SpatialHash::_cell(NumType coord) const
+{
+	static constexpr double LIMIT = double(1ll << 62);
+	double c = floor(double(coord) / _cell_size);
+	if (!(c > -LIMIT)) return -(1ll << 62); // Also for NaN (and -inf)
+	if (!(c <  LIMIT)) return   1ll << 62;
+	return int64_t(c);
+}
+
+//----------------------------------------------------------------------------
+void SpatialHash::build(const World& world)
+{
+ZoneScoped;
+	const auto& bodies = world.bodies;
+	const auto n = bodies.size();
+
+	// Separate the large ones (see the class comment)...
+	_radii.clear();
+	for (size_t i = 0; i < n; ++i)
+		if (!bodies.terminated(i)) _radii.push_back(bodies.r[i]);
+	NumType r_limit = 0;
+	if (!_radii.empty()) {
+		auto mid = _radii.begin() + _radii.size() / 2;
+		nth_element(_radii.begin(), mid, _radii.end());
+		r_limit = LARGE_R_RATIO * *mid;
+	}
+
+	_large.clear();
+	_is_large.assign(n, false);
+	NumType r_max = 0;
+	for (size_t i = 0; i < n; ++i) {
+		if (bodies.terminated(i)) continue;
+		if (bodies.r[i] > r_limit && r_limit > 0) { _large.push_back(Index(i)); _is_large[i] = true; }
+		else r_max = max(r_max, bodies.r[i]);
+	}
+	_cell_size = r_max > 0 ? 2 * r_max : 1;
+
+	size_t buckets = 16;
+	while (buckets < n) buckets *= 2;
+	_mask = buckets - 1;
+
+	// Counting sort of the bodies by bucket...
+	_bucket_start.assign(buckets + 1, 0);
+	for (size_t i = 0; i < n; ++i) {
+		if (bodies.terminated(i) || _is_large[i]) continue;
+		++_bucket_start[_bucket(_cell(bodies.px[i]), _cell(bodies.py[i])) + 1];
+	}
+	for (size_t b = 0; b < buckets; ++b)
+		_bucket_start[b + 1] += _bucket_start[b];
+
+	_items.resize(_bucket_start[buckets]);
+	_fill.assign(_bucket_start.begin(), _bucket_start.end() - 1);
+	for (size_t i = 0; i < n; ++i) { //! In index order, so the buckets will be sorted, too
+		if (bodies.terminated(i) || _is_large[i]) continue;
+		_items[_fill[_bucket(_cell(bodies.px[i]), _cell(bodies.py[i]))]++] = Index(i);
+	}
+}
+
+//----------------------------------------------------------------------------
+void SpatialHash::find_collisions(const World& world, bool both_ways, bool interact_all, vector<Pair>& out) const
+{
+ZoneScoped;
+	const auto& bodies = world.bodies;
+	out.clear();
+	if (_items.empty() && _large.empty()) return;
+
+	auto check = [&](size_t target, size_t source) { // Same calc. as in the exact loop
+		auto ddx = bodies.px[source] - bodies.px[target],
+		     ddy = bodies.py[source] - bodies.py[target];
+		auto distance = Math::mag2(ddx, ddy);
+
+		if (world.is_colliding(target, source, distance)) {
+			out.push_back({target, source, distance});
+			if (both_ways && interact_all) out.push_back({source, target, distance});
+		}
+	};
+
+	const size_t sources = interact_all ? bodies.size() : min(bodies.size(), size_t(1));
+	for (size_t source = 0; source < sources; ++source) {
+		if (bodies.terminated(source)) continue;
+
+		// A large one against everything:
+		if (_is_large[source]) {
+			for (size_t target = source + 1; target < bodies.size(); ++target)
+				if (!bodies.terminated(target)) check(target, source);
+			continue;
+		}
+
+		// A small one against the large ones (if any), ...
+		for (auto it = upper_bound(_large.begin(), _large.end(), Index(source)); it != _large.end(); ++it)
+			check(*it, source);
+
+		// ... and against the small ones in its neighbourhood:
+		auto cx = _cell(bodies.px[source]), cy = _cell(bodies.py[source]);
+
+		// The neighbouring cells may well share buckets, so skip the repeats:
+		size_t seen[9]; unsigned seen_cnt = 0;
+		for (int dy = -1; dy <= 1; ++dy) for (int dx = -1; dx <= 1; ++dx) {
+			auto b = _bucket(cx + dx, cy + dy);
+			if (find(seen, seen + seen_cnt, b) != seen + seen_cnt) continue;
+			seen[seen_cnt++] = b;
+
+			for (auto k = _bucket_start[b]; k < _bucket_start[b + 1]; ++k) {
+				size_t target = _items[k];
+				if (target <= source) continue; // Each pair only once here
+				check(target, source);
+			}
+		}
+	}
+
+	sort(out.begin(), out.end(), [](auto& a, auto& b) {
+		return a.source != b.source ? a.source < b.source : a.target < b.target;
+	});
+}
+
+
+//============================================================================
+void World::update_collisions_broadphase(Szim::SimApp& app)
+// Call the collision hooks for all the colliding pairs, without going through
+// all the pairs (so the solvers can skip it, see `broadphase`).
+{
+ZoneScoped;
+	static SpatialHash grid;             // Static to reuse its buffers across ticks
+	static vector<SpatialHash::Pair> pairs; // - " -
+
+	grid.build(*this);
+#ifndef DISABLE_FULL_INTERACTION_LOOP
+	const bool both_ways = loop_mode == LoopMode::Full;
+#else
+	const bool both_ways = false;
+#endif
+	grid.find_collisions(*this, both_ways, _interact_all, pairs);
+
+	for (auto& p : pairs) _collide(p.target, p.source, p.distance, app);
+}
+
+} // namespace Model
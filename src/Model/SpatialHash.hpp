@@ -0,0 +1,70 @@
+#ifndef _SH6P1Y8WQ3N0KZ7TR52XV9MC4BJ0DL3G_
+#define _SH6P1Y8WQ3N0KZ7TR52XV9MC4BJ0DL3G_
+
+#include "Model/World.hpp"
+
+#include <vector>
+#include <cstdint>
+
+namespace Model {
+
+//============================================================================
+// Spatial hash (uniform grid) broadphase for the collision detection
+//
+// The cells are (at least) as big as the largest body, so any pair that can
+// collide is either in the same cell, or in two neighbouring ones. The grid
+// itself is unbounded: the cells are hashed into a table of buckets (sized
+// to the number of bodies), so it's O(n) both in time and space.
+//
+// The few bodies much larger than the typical (like the player's globe) are
+// kept out of the grid (and its cell size), as they would otherwise make the
+// cells so big that most bodies would end up in just a few of them (making it
+// O(n^2) again). They are just tested against everything instead.
+//
+// Rebuilt from scratch in every tick, reusing its buffers.
+//
+class SpatialHash
+{
+public:
+	using NumType = World::NumType;
+	using Index = uint32_t;
+
+	struct Pair
+	{
+		size_t target, source; // Same roles as in the exact interaction loop
+		NumType distance;
+	};
+
+	void build(const World& world);
+
+	// Collect the colliding pairs (as per World::is_colliding()), in the order
+	// the exact loop would find them: by source, then target. Each pair once
+	// (the lower index being the source), or both ways (for the Full loop).
+	// If !interact_all, only the pairs with body #0 (as the source).
+	void find_collisions(const World& world, bool both_ways, bool interact_all, std::vector<Pair>& out) const;
+
+	NumType cell_size() const { return _cell_size; }
+	const std::vector<Index>& large() const { return _large; }
+
+	static constexpr NumType LARGE_R_RATIO = 8; // Bodies with r > this * the median r are "large"
+
+protected:
+	size_t _bucket(int64_t cx, int64_t cy) const {
+		// The usual "large primes" spatial hash:
+		return size_t((uint64_t(cx) * 73856093u) ^ (uint64_t(cy) * 19349663u)) & _mask;
+	}
+	int64_t _cell(NumType coord) const;
+
+	NumType _cell_size = 1;
+	size_t _mask = 0;
+	std::vector<Index> _bucket_start; // Start of each bucket in _items (+ 1 past the end)
+	std::vector<Index> _items;        // Body indexes, grouped by bucket
+	std::vector<Index> _fill;         // Temp. for the counting sort
+	std::vector<Index> _large;        // Body indexes, ascending (not in the grid)
+	std::vector<uint8_t> _is_large;   // For each body
+	std::vector<NumType> _radii;      // Temp. for the median
+};
+
+} // namespace Model
+
+#endif // _SH6P1Y8WQ3N0KZ7TR52XV9MC4BJ0DL3G_
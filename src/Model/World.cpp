@@ -16,6 +16,7 @@
 
 #include <cassert>
 #include <cmath> // sqrt, pow?
+#include <algorithm> // max, fill
 //!!NOT YET! Too cumbersome for the trivial alternative.
 //!!#include <optional>
 //!!	using std::optional, std::nullopt;
@@ -40,7 +41,9 @@ using namespace Math;
 //============================================================================
 World::World() :
 	gravity_mode(GravityMode::Default),
-	loop_mode(LoopMode::Default)
+	integrator(Integrator::Default),
+	loop_mode(LoopMode::Default),
+	gravity_solver(GravitySolver::Default)
 {
 }
 
@@ -48,9 +51,8 @@ World::World() :
 size_t World::add_body(Body const& obj)
 {
 ZoneScoped; //!!IPROF("add_body-copy");
-	bodies.push_back(std::make_shared<Body>(obj));
-	auto ndx = bodies.size() - 1;
-	bodies[ndx]->recalc();
+	auto ndx = bodies.push_back(obj);
+	bodies[ndx].recalc();
 	return ndx;
 }
 
@@ -58,8 +60,19 @@ size_t World::add_body(Body&& obj)
 {
 ZoneScoped; //!!IPROF("add_body-move");
 	obj.recalc(); // just recalc the original throw-away obj
-	bodies.emplace_back(std::make_shared<Body>(obj));
-	return bodies.size() - 1;
+	return bodies.push_back(obj);
+}
+
+size_t World::add_bodies(std::span<const Body> objs)
+{
+ZoneScoped;
+	auto first = bodies.size();
+	bodies.reserve_more(objs.size());
+	for (const auto& obj : objs) {
+		auto ndx = bodies.push_back(obj);
+		bodies[ndx].recalc();
+	}
+	return first;
 }
 
 void World::remove_body(size_t ndx)
@@ -67,7 +80,225 @@ void World::remove_body(size_t ndx)
 ZoneScoped;
 	assert(bodies.size() > 0);
 	assert(ndx != (size_t)-1);
-	bodies.erase(bodies.begin() + ndx);
+	bodies.erase(ndx);
+}
+
+size_t World::remove_terminated_bodies(std::vector<size_t>* removed)
+{
+ZoneScoped;
+	return bodies.erase_terminated(removed);
+}
+
+
+//============================================================================
+void World::BodyStore::reserve(size_t n)
+{
+	if (n <= capacity()) return;
+	++_stats.regrowths;
+	_for_each_array([n](auto& a) { a.reserve(n); });
+}
+
+void World::BodyStore::reserve_more(size_t n)
+//! Not just reserve(size() + n), as that would realloc. on every burst!
+{
+	if (size() + n <= capacity()) return;
+	reserve(max({size() + n, capacity() * 2, MIN_CAPACITY}));
+}
+
+void World::BodyStore::clear()
+{
+	for (auto slot : _slot_of) { //! Not just dropping the slots, to keep invalidating the old handles!
+		++_slots[slot].generation;
+		_slots[slot].index = NoIndex;
+		_free_slots.push_back(slot);
+	}
+	_for_each_array([](auto& a) { a.clear(); });
+	_for_each_activity_list([](auto& list, auto) { list.clear(); });
+	_changed.clear();
+}
+
+size_t World::BodyStore::push_back(const Body& obj)
+{
+	reserve_more(1); //! Keeping all the arrays in lockstep (and counting the reallocs)
+
+	px.push_back(obj.p.x);
+	py.push_back(obj.p.y);
+	vx.push_back(obj.v.x);
+	vy.push_back(obj.v.y);
+	mass.push_back(obj.mass);
+	r.push_back(obj.r);
+	lifetime.push_back(obj.lifetime);
+	T.push_back(obj.T);
+	superpower.push_back(obj.superpower);
+	ax.push_back(Math::MyNaN<NumType>);
+	ay.push_back(Math::MyNaN<NumType>);
+	step_level.push_back(0);
+	recalced.push_back({});
+	activity.push_back(Changed); //! Classified later, as the app may still change it right away (e.g. OONApp::spawn())
+	_changed.push_back(cold.size());
+	cold.push_back(obj);
+
+	uint32_t slot;
+	if (_free_slots.empty()) {
+		slot = (uint32_t)_slots.size();
+		_slots.push_back({.index = 0, .generation = 0});
+		++_stats.new_slots;
+	} else {
+		slot = _free_slots.back();
+		_free_slots.pop_back();
+	}
+	_slots[slot].index = cold.size() - 1;
+	_slot_of.push_back(slot);
+
+	return cold.size() - 1;
+}
+
+void World::BodyStore::erase(size_t ndx)
+{
+	assert(ndx < size());
+	auto last = size() - 1;
+
+	auto slot = _slot_of[ndx];
+	++_slots[slot].generation;
+	_slots[slot].index = NoIndex;
+	_free_slots.push_back(slot);
+
+	const bool ndx_changed = activity[ndx] & Changed, last_changed = activity[last] & Changed; // (Before the move)
+
+	if (ndx != last) {
+		_for_each_array([ndx, last](auto& a) { a[ndx] = std::move(a[last]); });
+		_slots[_slot_of[ndx]].index = ndx;
+	}
+	_for_each_array([](auto& a) { a.pop_back(); });
+
+	// Follow the move in the index lists, too... The activity lists are sorted,
+	// so `last` (the highest index) can only be at the end, and then it just
+	// needs to be rotated to its new place (no full search or re-sorting):
+	_for_each_activity_list([ndx, last](auto& list, auto) {
+		if (auto it = std::lower_bound(list.begin(), list.end(), ndx); it != list.end() && *it == ndx)
+			list.erase(it);
+		if (ndx != last && !list.empty() && list.back() == last) {
+			list.back() = ndx;
+			std::rotate(std::lower_bound(list.begin(), list.end() - 1, ndx), list.end() - 1, list.end());
+		}
+	});
+	// ...while _changed is not sorted (and only has those flagged Changed):
+	if (ndx_changed) {
+		auto it = std::find(_changed.begin(), _changed.end(), ndx);
+		assert(it != _changed.end());
+		*it = _changed.back(); _changed.pop_back();
+	}
+	if (ndx != last && last_changed) {
+		auto it = std::find(_changed.begin(), _changed.end(), last);
+		assert(it != _changed.end());
+		*it = ndx;
+	}
+}
+
+size_t World::BodyStore::erase_terminated(std::vector<size_t>* removed)
+{
+	if (removed) removed->clear();
+
+	static std::vector<size_t> new_index; // For remapping the index lists (NoIndex: removed)
+	new_index.resize(size());
+
+	size_t kept = 0;
+	for (size_t i = 0; i < size(); ++i) {
+		if (terminated(i)) {
+			auto slot = _slot_of[i];
+			++_slots[slot].generation;
+			_slots[slot].index = NoIndex;
+			_free_slots.push_back(slot);
+			if (removed) removed->push_back(i);
+			new_index[i] = NoIndex;
+			continue;
+		}
+		if (kept != i) {
+			_for_each_array([kept, i](auto& a) { a[kept] = std::move(a[i]); });
+			_slots[_slot_of[kept]].index = kept;
+		}
+		new_index[i] = kept;
+		++kept;
+	}
+
+	auto count = size() - kept;
+	if (!count) return 0;
+
+	_for_each_array([kept](auto& a) { a.erase(a.begin() + kept, a.end()); });
+
+	// The order is kept, so the index lists stay sorted, too:
+	auto remap = [](std::vector<size_t>& list) {
+		size_t n = 0;
+		for (auto i : list) if (new_index[i] != NoIndex) list[n++] = new_index[i];
+		list.resize(n);
+	};
+	_for_each_activity_list([&](auto& list, auto) { remap(list); });
+	remap(_changed);
+
+	return count;
+}
+
+World::BodyRef World::BodyStore::operator[](size_t ndx)
+{
+	assert(ndx < size());
+	if (!(activity[ndx] & Changed)) { // The app may change anything via the ref, so reclassify it later
+		activity[ndx] |= Changed;
+		_changed.push_back(ndx);
+	}
+	return ref(ndx);
+}
+
+World::BodyRef World::BodyStore::ref(size_t ndx)
+{
+	assert(ndx < size());
+	auto& c = cold[ndx];
+	return { superpower[ndx], lifetime[ndx], r[ndx], c.density,
+	         {px[ndx], py[ndx]}, {vx[ndx], vy[ndx]},
+	         T[ndx], c.color, mass[ndx],
+	         c.thrust_up, c.thrust_down, c.thrust_left, c.thrust_right,
+	         recalced[ndx] };
+}
+
+void World::BodyStore::update_activity()
+{
+	if (_changed.empty()) return;
+
+	uint8_t added = 0, dropped = 0;
+	for (auto i : _changed) {
+		auto was = uint8_t(activity[i] & ~Changed);
+		auto now = uint8_t((lifetime[i] > 0 ? Expiring : 0)
+		                 | (T[i] > 0 ? Hot : 0)
+		                 | (cold[i].has_thruster() ? Thrusting : 0));
+		activity[i] = now;
+		added   |= now & ~was;
+		dropped |= was & ~now;
+		_for_each_activity_list([&](auto& list, auto flag) { if (now & ~was & flag) list.push_back(i); });
+	}
+
+	_for_each_activity_list([&](auto& list, auto flag) {
+		if (dropped & flag) {
+			std::erase_if(list, [&](size_t i) { return !(activity[i] & flag); });
+		}
+		if ((added & flag) && !std::is_sorted(list.begin(), list.end())) { // The new ones were appended
+			std::sort(list.begin(), list.end());
+		}
+	});
+
+	_changed.clear();
+}
+
+World::Body World::BodyStore::get(size_t ndx) const
+{
+	assert(ndx < size());
+	Body b = cold[ndx];
+	b.superpower = superpower[ndx];
+	b.lifetime = lifetime[ndx];
+	b.T = T[ndx];
+	b.r = r[ndx];
+	b.p = {px[ndx], py[ndx]};
+	b.v = {vx[ndx], vy[ndx]};
+	b.mass = mass[ndx];
+	return b;
 }
 
 
@@ -81,8 +312,17 @@ void World::update(float dt, SimApp& app)
 //!! Should be idempotent -- doesn't matter normally, but testing could reveal bugs if it isn't!
 {
 	update_before_interactions(dt, app);
-	update_pairwise_interactions(dt, app);
-	update_after_interactions(dt, app);
+	if (max_step_level) {
+		_own_accelerations(AccelOwner::BlockSteps); //! Not the VelocityVerlet ones: those include the hooks' dv, too!
+		update_block_steps(dt, app);
+	} else {
+		_own_accelerations(integrator == Integrator::VelocityVerlet ? AccelOwner::VelocityVerlet : AccelOwner::None);
+		_integrate_before_interactions(dt);
+		update_pairwise_interactions(dt, app);
+		update_after_interactions(dt, app);
+	}
+	particles.update(dt, *this);
+	++_ticks_since_reorder;
 }
 
 //----------------------------------------------------------------------------
@@ -95,10 +335,22 @@ void World::update(float dt, SimApp& app)
         //!! not just entirely skipping some frames for all (-> jitter!)
 
 
+//----------------------------------------------------------------------------
+// Call f(first, end) for each run of consecutive indexes in an ascending list:
+template <typename F> static void for_each_run(const std::vector<size_t>& list, F&& f)
+{
+	for (size_t k = 0; k < list.size();) {
+		auto first = list[k], end = first + 1;
+		while (++k < list.size() && list[k] == end) ++end;
+		f(first, end);
+	}
+}
+
 //----------------------------------------------------------------------------
 void World::update_before_interactions(float dt, Szim::SimApp& app [[maybe_unused]])
 {
 ZoneScoped;
+	bodies.update_activity(); //! Even if paused, so the changes don't just pile up
 
 	if (dt == 0.f) { // (Whatever the accuracy of this, good enough.)
 		return;  // <- This may change later (perhaps selectively,
@@ -116,55 +368,87 @@ auto last_dt = dt;
 static int skipping_n_interactions = _PAIRWISE_UPDATE_SKIP_COUNT_;
 #endif
 
-	// Go through autogenic effects first:
-	//!!This should be a separate collection tho; super wasteful to go thru all every time!
-	for (size_t i = 0; i < bodies.size(); ++i)
-	{
-		auto& body = bodies[i];
-
-		// Lifecycle mgmt... -- mark and skip decaying objects:
-		if (body->can_expire()) {
-			body->lifetime -= dt;
-			if (body->lifetime <= 0) {
-				body->terminate(); // Set to a well-defined state that's easy to check later!
-				body->on_event(Event::Terminated);
-
-				//!!bodies.erase(i);... //!!Watch out for the loop then, as this would make the indexes/iterators invalid!!
-				                        //!!Better just to mark it DELETED, and let another loop remove them later!
+	// Go through autogenic effects first -- only for the bodies they apply to,
+	// each effect in its own pass over its (ascending) list of them (see
+	// BodyStore::update_activity()). The arithmetic is done over the runs of
+	// consecutive indexes in the lists (mostly long ones, as most of these are
+	// particles, emitted in bursts), as plain contiguous (vectorizable) loops,
+	// and only the rare events (decay, recalc) are handled one by one.
+	//! The world keeps these lists up to date itself, so the bodies are only
+	//! accessed via ref() here, not operator[] (which would flag them Changed).
+
+	// Lifecycle mgmt... -- mark (and later skip) decaying objects:
+	for_each_run(bodies.expiring, [&](size_t first, size_t end) {
+		auto* lifetime = bodies.lifetime.data();
+		for (auto i = first; i < end; ++i) lifetime[i] -= dt;
+	});
+	size_t kept = 0;
+	for (auto i : bodies.expiring) {
+		if (bodies.lifetime[i] > 0) { bodies.expiring[kept++] = i; continue; }
+
+		auto body = bodies.ref(i);
+		body.terminate(); // Set to a well-defined state that's easy to check later!
+		body.on_event(Event::Terminated);
+		bodies.activity[i] &= ~BodyStore::Expiring;
+
+		//!!bodies.erase(i);... //!!Watch out for the loop then, as this would make the indexes/iterators invalid!!
+		                        //!!Better just to mark it DELETED, and let another loop remove them later!
 //cerr << "#"<<i <<" DECAYED\n";
-				continue;
-			}
+	}
+	bodies.expiring.resize(kept);
+	//! The terminated ones are removed after every update (see the app), so the
+	//! ones terminated() from now on are the ones decaying just now, skipping the
+	//! rest of the effects.
+
+	// As a placeholder for real thermodynamics, just auto-cool objects for now:
+	size_t cooled_off = 0;
+	for_each_run(bodies.hot, [&](size_t first, size_t end) {
+		auto* T = bodies.T.data();
+		const auto* lifetime = bodies.lifetime.data();
+		for (auto i = first; i < end; ++i) {
+			T[i] *= lifetime[i] == 0 ? 1.f : 0.996f; //!! even 0.995 already cools back down too fast to form "black holes"
+			cooled_off += T[i] <= 0;
 		}
-
-		// As a placeholder for real thermodynamics, just auto-cool objects for now:
-		if (body->T > 0) {
-			body->T *= 0.996f; //!! even 0.995 already cools back down too fast to form "black holes"
-
-			//!! Here should be an optimized progression to different "T color regimes"
-			//!! to avoid calling recalc() on every single tick!
-			//!! The temp. change should happen, and then either a quick condition here
-			//!! should detect change in "abstract color" (similar to B-V), or the renderer
-			//!! should always unconditionally map T to real color...
-			//!!
-			//!! Well, OK, doing a "skiprate" refresh here, so that's gonna be the condition then...
+	});
+
+	//!! Here should be an optimized progression to different "T color regimes"
+	//!! to avoid calling recalc() on every single tick!
+	//!! The temp. change should happen, and then either a quick condition here
+	//!! should detect change in "abstract color" (similar to B-V), or the renderer
+	//!! should always unconditionally map T to real color...
+	//!!
+	//!! Well, OK, doing a "skiprate" refresh here, so that's gonna be the condition then...
 #ifdef _AUTOGENIC_UPDATE_SKIP_COUNT_
-			if (!--skipping_T_recalc) {
-				skipping_T_recalc = _AUTOGENIC_UPDATE_SKIP_COUNT_ * 10;
-				body->recalc();
-//cerr << "#"<<i <<" Recalculated (T = " << body->T << ").\n";
-			}
+	// Every Nth of the list (the count continuing across ticks):
+	size_t next_recalc = skipping_T_recalc - 1;
+	for (; next_recalc < bodies.hot.size(); next_recalc += _AUTOGENIC_UPDATE_SKIP_COUNT_ * 10) {
+		auto i = bodies.hot[next_recalc];
+		if (!bodies.terminated(i)) bodies.ref(i).recalc();
+//cerr << "#"<<i <<" Recalculated (T = " << bodies.T[i] << ").\n";
+	}
+	skipping_T_recalc = int(next_recalc - bodies.hot.size() + 1);
 #endif
-//cerr << "#"<<i <<" Cooled to " << body->T << "...\n";
-		}
 
-		// Thrust -- for objects with (working) thrusters...:
-		if (body->has_thruster()) {
-			Vector2<NumType> F_thr(
-				(-body->thrust_left.thrust_level() + body->thrust_right.thrust_level()) * dt,
-				( body->thrust_up.thrust_level()   - body->thrust_down.thrust_level() ) * dt
-			);
-			body->v += (F_thr / body->mass);
-		}
+	if (cooled_off) { // Well, only after an eternity...
+		std::erase_if(bodies.hot, [&](size_t i) {
+			if (bodies.T[i] > 0) return false;
+			bodies.activity[i] &= ~BodyStore::Hot;
+			return true;
+		});
+	}
+
+	// Thrust -- for objects with (working) thrusters...:
+	for (auto i : bodies.thrusting) {
+		if (bodies.terminated(i)) continue;
+
+		const auto& body = bodies.cold[i]; // The thrusters are only there
+		Vector2<NumType> F_thr(
+			(-body.thrust_left.thrust_level() + body.thrust_right.thrust_level()) * dt,
+			( body.thrust_up.thrust_level()   - body.thrust_down.thrust_level() ) * dt
+		);
+		auto dv = F_thr / bodies.mass[i];
+		bodies.vx[i] += dv.x;
+		bodies.vy[i] += dv.y;
 	}
 
 #if defined(_AUTOGENIC_UPDATE_SKIP_COUNT_) && defined(_PAIRWISE_UPDATE_SKIP_COUNT_)
@@ -182,32 +466,19 @@ if (_AUTOGENIC_UPDATE_SKIP_COUNT_ && --skipping_n_interactions) {
 }
 
 //----------------------------------------------------------------------------
-void World::update_pairwise_interactions(float dt, Szim::SimApp& app)
-{
-// Now do the interaction matrix:
-//!!
-//!! PROTECT AGAINST OTHER THREADS POTENTIALLY ADDING/DELETING OBJECTS!
-//!!
-
-//!!--------------------------------------------------------------------------
-//!! JUST FOR A REMINDER, NOTHING SERIOUS (OR EVEN MEANINGFUL) YET!
-//!! (E.g. the loops may well be just unsuitable for such optim. as-is.)
-//!!
-// Compiler boost:
-// - MSVC:
-//   Overall vectorization & floating-point loop optim.
-//   https://learn.microsoft.com/en-us/cpp/parallel/openmp/openmp-simd?view=msvc-170
-//   FTR: No significant diff.; /fp:fast was a lot more immediately noticable.
-//        In fact, adding /openmp on top of /fp:fast *DEGRADED* the performance! :-o
+template <World::GravityMode GM, World::LoopMode LM, bool IMMUNITY>
+void World::_pairwise_loop(float dt, Szim::SimApp& app)
+// The exact (scalar) interaction loop, specialized for the gravity and loop
+// modes, and for whether any body has gravity immunity, so the inner loop has
+// no branches on those. (The calculations are still the very same, so it's
+// still bit-exact with the original, which the regression tests depend on.)
 //
-#ifdef _MSC_VER
-//# pragma vector // CPP2022+ (mine can't do it)
-//# pragma ivdep  // CPP2022+ (mine can't do it)
-//# pragma omp simd // Must be put directly before a `for`!
-//!! ... simdlen(8): which version? mine can't do it
-#endif
-//!!
-//!!--------------------------------------------------------------------------
+//! The immunity flag is only checked once per tick, so if a hook grants it to
+//! a body in the loop, that'll only take effect from the next tick.
+//
+// See test/perf/pairwise-loop.cmd for measuring it.
+{
+	using enum GravityMode;
 
 auto obj_cnt = bodies.size();
 #ifdef _MSC_VER
@@ -217,9 +488,7 @@ for (size_t source_obj_ndx = 0; source_obj_ndx < (_interact_all ? obj_cnt : 1);
 	//!! That 1 is incompatible with `interact_all` actually! Should be 0, and 1 only with `interact_playeronly`!
 	//!! Hard-coded to player-entity-index == 0, and ignores any other (potential) players!...
 {
-	using enum GravityMode;
-
-	if (bodies[source_obj_ndx]->terminated())
+	if (bodies.terminated(source_obj_ndx))
 		continue;
 
 #ifdef _MSC_VER
@@ -227,7 +496,7 @@ for (size_t source_obj_ndx = 0; source_obj_ndx < (_interact_all ? obj_cnt : 1);
 #endif
 #ifndef DISABLE_FULL_INTERACTION_LOOP
 	// Iterate over the pairs both ways in Full mode...
-	for (size_t target_obj_ndx = loop_mode == LoopMode::Full ? 0 : source_obj_ndx + 1;
+	for (size_t target_obj_ndx = LM == LoopMode::Full ? 0 : source_obj_ndx + 1;
 		target_obj_ndx < obj_cnt; ++target_obj_ndx)
 #else
 	// Iterate over the pairs once only, doubling any bidirect. interactions inside the inner cycle!
@@ -239,18 +508,17 @@ for (size_t source_obj_ndx = 0; source_obj_ndx < (_interact_all ? obj_cnt : 1);
 
 		if (source_obj_ndx == target_obj_ndx) continue; // Skip itself...
 
-		Body* target = bodies[target_obj_ndx].get(); //! shared_ptr
-		if (target->terminated()) continue;
+		if (bodies.terminated(target_obj_ndx)) continue;
 
-		Body* source = bodies[source_obj_ndx].get();
+		const auto target = target_obj_ndx, source = source_obj_ndx; // Just for brevity...
 
 		// Collisions & gravity...
 		//!! see the relative looping now! if (i != source_obj_ndx)
 		{
-			auto dx = source->p.x - target->p.x,
-			     dy = source->p.y - target->p.y;
+			auto dx = bodies.px[source] - bodies.px[target],
+			     dy = bodies.py[source] - bodies.py[target];
 
-//			auto distance = Math::distance2(target->p.x, target->p.y, source->p.x, source->p.y);
+//			auto distance = Math::distance2(bodies.px[target], bodies.py[target], bodies.px[source], bodies.py[source]);
 			auto distance = Math::mag2(dx, dy);
 
 			//! Collision det. is crucial also for preventing 0 distance to divide by!
@@ -272,6 +540,8 @@ for (size_t source_obj_ndx = 0; source_obj_ndx < (_interact_all ? obj_cnt : 1);
 			//! Done before actually reaching the body (so we can avoid the occasional frame showing the penetration :) )!
 			//  (Opting for the perhaps even less natural "but didn't even touch!" issue...)
 
+				if (broadphase) continue; // The hooks have already been called then (and no gravity while colliding)
+
 				// If the collision results in a well-defined fixed position/velocity etc.,
 				// they may need special treatment, because at this point the checked body may not
 				// yet have reached (or crossed the boundary of) the other, so it needs to be adjusted
@@ -283,18 +553,18 @@ for (size_t source_obj_ndx = 0; source_obj_ndx < (_interact_all ? obj_cnt : 1);
 				// so that the calc. can take into consideration the relative speed!
 //!!			auto rel_dv = distance2(target->v.x, target->v.y, source->v.x, source->v.y);
 				static constexpr float EPS_COLLISION = CFG_GLOBE_RADIUS/10; //!! experimental guesstimate (was: 100000); should depend on the relative speed!
-				if (abs(distance - (target->r + source->r)) < EPS_COLLISION ) {
+				if (abs(distance - (bodies.r[target] + bodies.r[source])) < EPS_COLLISION ) {
 //cerr << "Touch!\n";
-					if (!app.touch_hook(this, target, source)) {
+					if (!app.touch_hook(this, bodies[target], bodies[source])) {
 						;
 					}
 				} else {
-//cerr << " - Collided, but NO TOUCH. d = " << distance << ", delta = "<<abs(distance - (target->r + source->r)) << " (epsilon = "<<EPS_COLLISION<<")\n";
+//cerr << " - Collided, but NO TOUCH. d = " << distance << ", delta = "<<abs(distance - (bodies.r[target] + bodies.r[source])) << " (epsilon = "<<EPS_COLLISION<<")\n";
 				}
 
 				// Note: calling the hook before processing the collision!
 				// If the listener returns false, it didn't process it, so we should.
-				if (!app.collide_hook(this, target, source, distance)) {
+				if (!app.collide_hook(this, bodies[target], bodies[source], distance)) {
 
 					//!! Handle this in a hook:
 					//target->v = {0, 0}; // - or bounce, or stick to the other body and take its v, or any other sort of interaction...
@@ -325,33 +595,32 @@ for (size_t source_obj_ndx = 0; source_obj_ndx < (_interact_all ? obj_cnt : 1);
 				//!!app.directed_interaction_hook(this, source, target, dt, distance);
 					//!! Wow, this fn. call costs an FPS drop from ~175 to ~165 with 500 objs.! :-/
 #ifndef DISABLE_FULL_INTERACTION_LOOP
-if (loop_mode == LoopMode::Full) { // #65... Separate cycles for the two halves of the interaction is 10-12% SLOWER! :-o
-	switch (gravity_mode) {
-	case Hyperbolic: // #65... Separate cycles for the two halves of the interaction is 10-12% SLOWER! :-o
+if constexpr (LM == LoopMode::Full) { // #65... Separate cycles for the two halves of the interaction is 10-12% SLOWER! :-o
+	if constexpr (GM == Hyperbolic) {
 
-				if (!target->superpower.gravity_immunity) {
+				if (!IMMUNITY || !bodies.superpower[target].gravity_immunity) {
 				  //! Note: doing it branchless, i.e. multiplying with the bool flag (as 0 or 1)
 				  //! made it significantly _slower_! :-o
-					NumType a = gravity * source->mass / (distance * distance);
+					NumType a = gravity * bodies.mass[source] / (distance * distance);
 					auto dv = Vector2<NumType>{dx * a, dy * a} * NumType(dt); // #525: dx/distance, dy/distance...
 					//! Optimizing ...*dt into a dv scaling factor (a*dt) resulted in
 					//! rounding errors & failed regression testing... But should be fine:
-//					float _dvscale = gravity * source->mass / (distance*distance) * dt;
+//					float _dvscale = gravity * bodies.mass[source] / (distance*distance) * dt;
 //					auto _dv = Vector2<NumType>(dx * _dvscale, dy * _dvscale);
 /*!
 {static bool done=false;if(!done){done=true; // These look the same, but the calculations differ! :-o
 cerr << "dv : "<<  dv.x <<", "<<  dv.y <<"\n";
 cerr << "_dv: "<< _dv.x <<", "<< _dv.y <<"\n"; }}
 !*/
-					target->v += dv; //! += _dv;
+					bodies.vx[target] += dv.x; //! += _dv;
+					bodies.vy[target] += dv.y;
 				}
-		break;
-	case Realistic:
-	case Experimental:
-				if (!target->superpower.gravity_immunity) {
-					NumType a = gravity * source->mass / (distance * distance); //!!?? distance^3 too big for the divider?
+	} else if constexpr (GM == Realistic || GM == Experimental) {
+				if (!IMMUNITY || !bodies.superpower[target].gravity_immunity) {
+					NumType a = gravity * bodies.mass[source] / (distance * distance); //!!?? distance^3 too big for the divider?
 					auto dv = Vector2<NumType>{dx * a, dy * a} * NumType(dt/distance); // #525: dx/distance, dy/distance...
-					target->v += dv;
+					bodies.vx[target] += dv.x;
+					bodies.vy[target] += dv.y;
 /*!!
 if(((OONApp&)game).controls.ShowDebug) {
 	//!!This is useless, while the event loop is stalled, as the update loop here
@@ -360,43 +629,38 @@ if(((OONApp&)game).controls.ShowDebug) {
 }
 !!*/
 				}
-		break;
-//!!	case Experimental:
-//!!		assert(gravity_mode == Experimental);
-//!!		break;
-	default:
-		assert(gravity_mode == Off);
-		break;
-	} // switch (gravity_mode)
+	} // else: Off
 
 } else { // loop_mode == Half (-> #65)
 #endif // DISABLE_FULL_INTERACTION_LOOP
 
-	//!! Do the same switch here, too!
+	//!! Do the same for Experimental here, too!
 
-		if (gravity_mode == Hyperbolic) {
+		if constexpr (GM == Hyperbolic) {
 				const NumType G_dt_div_d2 = gravity / (distance * distance) * dt;
-				if (!target->superpower.gravity_immunity) {
-					auto a = G_dt_div_d2 * source->mass;
-					auto dv = Vector2<NumType>{dx * a, dy * a};
-					target->v += dv;
+				if (!IMMUNITY || !bodies.superpower[target].gravity_immunity) {
+					auto a = G_dt_div_d2 * bodies.mass[source];
+					bodies.vx[target] += dx * a;
+					bodies.vy[target] += dy * a;
 				}
-				if (!source->superpower.gravity_immunity) {
-					auto a = -G_dt_div_d2 * target->mass;
-					auto dv = Vector2<NumType>{dx * a, dy * a};
-					source->v += dv;
+				if (!IMMUNITY || !bodies.superpower[source].gravity_immunity) {
+					auto a = -G_dt_div_d2 * bodies.mass[target];
+					bodies.vx[source] += dx * a;
+					bodies.vy[source] += dy * a;
 				}
-		} else if (gravity_mode == Realistic) {
+		} else if constexpr (GM == Realistic) {
 				const NumType G_dt_div_d2 = gravity / (distance * distance) * dt; //!!?? distance^3 too big for the divider?
-				if (!target->superpower.gravity_immunity) {
-					auto a = G_dt_div_d2 * source->mass;
+				if (!IMMUNITY || !bodies.superpower[target].gravity_immunity) {
+					auto a = G_dt_div_d2 * bodies.mass[source];
 					auto dv = Vector2<NumType>{dx * a, dy * a} * NumType(dt/distance); // #525: dx/distance, dy/distance...
-					target->v += dv;
+					bodies.vx[target] += dv.x;
+					bodies.vy[target] += dv.y;
 				}
-				if (!source->superpower.gravity_immunity) {
-					auto a = -G_dt_div_d2 * target->mass;
+				if (!IMMUNITY || !bodies.superpower[source].gravity_immunity) {
+					auto a = -G_dt_div_d2 * bodies.mass[target];
 					auto dv = Vector2<NumType>{dx * a, dy * a} * NumType(dt/distance); // #525: dx/distance, dy/distance...
-					source->v += dv;
+					bodies.vx[source] += dv.x;
+					bodies.vy[source] += dv.y;
 				}
 		}
 
@@ -405,7 +669,7 @@ if(((OONApp&)game).controls.ShowDebug) {
 }
 #endif
 
-//cerr << "gravity pull on ["<<i<<"]: dist = "<<distance << ", g = "<<g << ", gv = ("<<target->v.x<<","<<target->v.y<<") " << endl;
+//cerr << "gravity pull on ["<<i<<"]: dist = "<<distance << ", g = "<<g << ", gv = ("<<bodies.vx[target]<<","<<bodies.vy[target]<<") " << endl;
 			}
 		} // if interacting with itself
 
@@ -418,6 +682,96 @@ if(((OONApp&)game).controls.ShowDebug) {
 //cerr << "v["<<i<<"] = ("<<target->v.x<<","<<target->v.y<<"), " << " dx = "<<ds.x << ", dy = "<<ds.y << ", dt = "<<dt << endl;
 	} // inner loop (of targets)
 } // outer loop (of soucres)
+}
+
+//----------------------------------------------------------------------------
+void World::update_pairwise_interactions(float dt, Szim::SimApp& app)
+{
+// Now do the interaction matrix:
+//!!
+//!! PROTECT AGAINST OTHER THREADS POTENTIALLY ADDING/DELETING OBJECTS!
+//!!
+
+//!!--------------------------------------------------------------------------
+//!! JUST FOR A REMINDER, NOTHING SERIOUS (OR EVEN MEANINGFUL) YET!
+//!! (E.g. the loops may well be just unsuitable for such optim. as-is.)
+//!!
+// Compiler boost:
+// - MSVC:
+//   Overall vectorization & floating-point loop optim.
+//   https://learn.microsoft.com/en-us/cpp/parallel/openmp/openmp-simd?view=msvc-170
+//   FTR: No significant diff.; /fp:fast was a lot more immediately noticable.
+//        In fact, adding /openmp on top of /fp:fast *DEGRADED* the performance! :-o
+//
+#ifdef _MSC_VER
+//# pragma vector // CPP2022+ (mine can't do it)
+//# pragma ivdep  // CPP2022+ (mine can't do it)
+//# pragma omp simd // Must be put directly before a `for`!
+//!! ... simdlen(8): which version? mine can't do it
+#endif
+//!!
+//!!--------------------------------------------------------------------------
+
+	if (broadphase) {
+		update_collisions_broadphase(app);
+		if (gravity_mode == GravityMode::Off) return; // Nothing left to do then
+	}
+
+	// Only the heavy ones pulling (the rest being test particles):
+	if (source_mass_ratio > 0 && _interact_all && gravity_mode != GravityMode::Off) {
+		update_pairwise_interactions_heavy(dt, app);
+		return;
+	}
+
+	// Only worth it (and only implemented) for the all-pairs case:
+	if (gravity_solver == GravitySolver::FMM && _interact_all && gravity_mode == GravityMode::Hyperbolic) {
+		update_pairwise_interactions_FMM(dt, app);
+		return;
+	}
+	// (Also for FMM with the other force laws, which have no complex-series expansion.)
+	if ((gravity_solver == GravitySolver::BarnesHut || gravity_solver == GravitySolver::FMM)
+	    && _interact_all && gravity_mode != GravityMode::Off) {
+		update_pairwise_interactions_BarnesHut(dt, app);
+		return;
+	}
+#ifndef DISABLE_THREADS
+	// Not worth splitting up a small matrix (or a single row, without _interact_all):
+	static constexpr size_t MT_MIN_BODIES = 500;
+	if (threads != 1 && _interact_all && bodies.size() >= MT_MIN_BODIES) {
+		update_pairwise_interactions_MT(dt, app);
+		return;
+	}
+#endif
+	if (simd) {
+		update_pairwise_interactions_SIMD(dt, app);
+		return;
+	}
+
+	// Select the specialized loop once per tick (see _pairwise_loop()):
+	using PairwiseLoop = void (World::*)(float, Szim::SimApp&);
+	using enum GravityMode;
+	static constexpr auto Half = LoopMode::Half, Full = LoopMode::Full;
+	static constexpr PairwiseLoop LOOPS[4][2][2] = { // [gravity_mode][loop_mode][immunity]
+		{{ &World::_pairwise_loop<Off, Half, false>,          &World::_pairwise_loop<Off, Half, true> },
+		 { &World::_pairwise_loop<Off, Full, false>,          &World::_pairwise_loop<Off, Full, true> }},
+		{{ &World::_pairwise_loop<Hyperbolic, Half, false>,   &World::_pairwise_loop<Hyperbolic, Half, true> },
+		 { &World::_pairwise_loop<Hyperbolic, Full, false>,   &World::_pairwise_loop<Hyperbolic, Full, true> }},
+		{{ &World::_pairwise_loop<Realistic, Half, false>,    &World::_pairwise_loop<Realistic, Half, true> },
+		 { &World::_pairwise_loop<Realistic, Full, false>,    &World::_pairwise_loop<Realistic, Full, true> }},
+		{{ &World::_pairwise_loop<Experimental, Half, false>, &World::_pairwise_loop<Experimental, Half, true> },
+		 { &World::_pairwise_loop<Experimental, Full, false>, &World::_pairwise_loop<Experimental, Full, true> }},
+	};
+#ifndef DISABLE_FULL_INTERACTION_LOOP
+	const auto lm = loop_mode == Full ? 1 : 0;
+#else
+	const auto lm = 0;
+#endif
+	bool any_immune = false;
+	for (size_t i = 0; i < bodies.size() && !any_immune; ++i)
+		any_immune = bodies.superpower[i].gravity_immunity;
+
+	assert(unsigned(gravity_mode) < 4);
+	(this->*LOOPS[unsigned(gravity_mode)][lm][any_immune])(dt, app);
 
 #ifdef _PAIRWISE_UPDATE_SKIP_COUNT_
 end_interact_loop:
@@ -425,26 +779,147 @@ dt = last_dt; // Restore "real dt" for calculations outside the "skip cheat"!
 #endif
 }
 
+//----------------------------------------------------------------------------
+void World::_collide(size_t target, size_t source, NumType distance, Szim::SimApp& app)
+{
+	static constexpr float EPS_COLLISION = CFG_GLOBE_RADIUS/10; //! Same as in the exact loop!
+	if (abs(distance - (bodies.r[target] + bodies.r[source])) < EPS_COLLISION) {
+		app.touch_hook(this, bodies[target], bodies[source]);
+	}
+	app.collide_hook(this, bodies[target], bodies[source], distance);
+}
+
 //----------------------------------------------------------------------------
 void World::update_after_interactions(float dt, Szim::SimApp& app)
 {
+	if (integrator != Integrator::Euler) {
+		_integrate_after_interactions(dt);
+		return;
+	}
+
 	// All-inclusive postprocessing loop for friction [but why here? test what diff it makes if done in the pre-interact. loop],
 	// and actually updating the positions finally
 	for (size_t obj_cnt = bodies.size(), i = 0; i < obj_cnt; ++i)
 	{
-		auto& body = bodies[i];
+		auto& vx = bodies.vx[i], & vy = bodies.vy[i];
 
 		// Friction - adjust velocities:
-		auto friction_decel = body->v * NumType(friction);
-		body->v -= friction_decel * NumType(dt);
+		auto friction_decel_x = vx * NumType(friction),
+		     friction_decel_y = vy * NumType(friction);
+		vx -= friction_decel_x * NumType(dt);
+		vy -= friction_decel_y * NumType(dt);
 		
 		// And finally, the positions:
 ///*!!
 if(((OONApp&)app).controls.ShowDebug) {
-	cerr << "#"<<i<<": moving this much: "<< body->v.x * dt <<", "<< body->v.x <<"\n";
+	cerr << "#"<<i<<": moving this much: "<< vx * dt <<", "<< vx <<"\n";
 }
 //!!*/
-		body->p += body->v * NumType(dt);
+		bodies.px[i] += vx * NumType(dt);
+		bodies.py[i] += vy * NumType(dt);
+	}
+}
+
+//----------------------------------------------------------------------------
+// The pairwise pass just adds a = F/m * dt to v (Euler's "kick"), so the 2nd-order
+// integrators are built around that, without touching the solvers:
+//
+//  - Leapfrog (DKD): drift dt/2, kick (the pairwise pass), drift dt/2
+//
+//  - Velocity Verlet (KDK): kick dt/2 with the accel. of the prev. tick, drift dt,
+//    then the pairwise pass at the new positions, but only keeping half of its dv
+//    (and saving its accel. for the next tick). The bodies with no prev. accel.
+//    yet (new, or just loaded) do a DKD step instead.
+//
+// Both are symplectic (so the orbits don't spiral in/out like with Euler), at
+// the cost of one force calc. per tick, same as Euler.
+//
+//! NOTE: Any velocity changes by the hooks during the pairwise pass count as
+//!       part of the accel. for VelocityVerlet!
+//
+void World::_integrate_before_interactions(float dt)
+{
+ZoneScoped;
+	if (integrator == Integrator::Euler || dt == 0.f) return;
+
+	const auto half_dt = NumType(dt) / 2;
+	const auto obj_cnt = bodies.size();
+
+	if (integrator == Integrator::Leapfrog) {
+		for (size_t i = 0; i < obj_cnt; ++i) {
+			bodies.px[i] += bodies.vx[i] * half_dt;
+			bodies.py[i] += bodies.vy[i] * half_dt;
+		}
+		return;
+	}
+
+	assert(integrator == Integrator::VelocityVerlet);
+	_v_prev_x.resize(obj_cnt);
+	_v_prev_y.resize(obj_cnt);
+	for (size_t i = 0; i < obj_cnt; ++i) {
+		auto& vx = bodies.vx[i], & vy = bodies.vy[i];
+		if (bodies.ax[i] == Math::MyNaN<NumType>) { // No accel. yet: DKD
+			bodies.px[i] += vx * half_dt;
+			bodies.py[i] += vy * half_dt;
+		} else {
+			vx += bodies.ax[i] * half_dt;
+			vy += bodies.ay[i] * half_dt;
+			bodies.px[i] += vx * NumType(dt);
+			bodies.py[i] += vy * NumType(dt);
+		}
+		_v_prev_x[i] = vx;
+		_v_prev_y[i] = vy;
+	}
+}
+
+//----------------------------------------------------------------------------
+void World::_own_accelerations(AccelOwner mode)
+// The accel. of the prev. tick is only valid for the mode that has been keeping
+// it up to date, so after switching modes (e.g. VelocityVerlet -> Euler for a
+// while -> VelocityVerlet, or block steps off and on again), it's all dropped
+// (to MyNaN), instead of kicking the bodies with some long stale one.
+{
+	if (mode == _accel_owner) return;
+	fill(bodies.ax.begin(), bodies.ax.end(), Math::MyNaN<NumType>);
+	fill(bodies.ay.begin(), bodies.ay.end(), Math::MyNaN<NumType>);
+	_accel_owner = mode;
+}
+
+//----------------------------------------------------------------------------
+void World::_integrate_after_interactions(float dt)
+{
+ZoneScoped;
+	const auto half_dt = NumType(dt) / 2;
+	//! The body count may have changed by the hooks, so only the ones already
+	//! there before the pairwise pass can be VV-stepped (the rest just get a DKD)!
+	const auto prev_cnt = integrator == Integrator::VelocityVerlet && dt != 0.f ? min(_v_prev_x.size(), bodies.size()) : 0;
+
+	for (size_t obj_cnt = bodies.size(), i = 0; i < obj_cnt; ++i)
+	{
+		auto& vx = bodies.vx[i], & vy = bodies.vy[i];
+
+		bool drift = true; // The 2nd half-drift of DKD
+		if (i < prev_cnt) {
+			// The accel. from the pairwise pass:
+			auto ax = (vx - _v_prev_x[i]) / NumType(dt),
+			     ay = (vy - _v_prev_y[i]) / NumType(dt);
+			if (bodies.ax[i] != Math::MyNaN<NumType>) { // KDK: only the 2nd half-kick
+				vx = _v_prev_x[i] + ax * half_dt;
+				vy = _v_prev_y[i] + ay * half_dt;
+				drift = false;
+			}
+			bodies.ax[i] = ax;
+			bodies.ay[i] = ay;
+		}
+
+		// Friction:
+		vx -= vx * NumType(friction) * NumType(dt);
+		vy -= vy * NumType(friction) * NumType(dt);
+
+		if (drift) {
+			bodies.px[i] += vx * half_dt;
+			bodies.py[i] += vy * half_dt;
+		}
 	}
 }
 
@@ -453,6 +928,29 @@ if(((OONApp&)app).controls.ShowDebug) {
 void World::_copy(World const& source)
 {
 //cerr << "World copy requested!\n";
+	if (&source != this)
+	{
+		assign_state(source);
+
+		loop_mode = source.loop_mode;
+		gravity_solver = source.gravity_solver;
+		bh_theta = source.bh_theta;
+		fmm_order = source.fmm_order;
+		fmm_check = source.fmm_check;
+		simd = source.simd;
+		source_mass_ratio = source.source_mass_ratio;
+		threads = source.threads;
+		broadphase = source.broadphase;
+		max_step_level = source.max_step_level;
+		step_eta = source.step_eta;
+		reorder_interval = source.reorder_interval;
+		particles = source.particles;
+	}
+}
+
+//----------------------------------------------------------------------------
+void World::assign_state(World const& source)
+{
 	if (&source != this)
 	{
 		//!! Move these into some props container to prevent forgetting
@@ -462,12 +960,20 @@ void World::_copy(World const& source)
 		gravity = source.gravity;
 		friction = source.friction;
 		gravity_mode = source.gravity_mode;
-		loop_mode = source.loop_mode;
+		integrator = source.integrator;
 		_interact_all = source._interact_all;
 
+		//! The processing options (loop_mode, gravity_solver ... reorder_interval,
+		//! and the particle pool setup) are left alone: they are not saved, so
+		//! the source of a load (a default-constructed World, filled by load())
+		//! would just reset them all, overriding the cfg and the cmdline (e.g.
+		//! --session with --fmm)! Only the leftover particles are dropped:
+		particles.clear();
+
 		bodies.clear();
-		for (const auto& b : source.bodies) {
-			add_body(*b);
+		bodies.reserve(source.bodies.size());
+		for (size_t i = 0; i < source.bodies.size(); ++i) {
+			add_body(source.bodies.get(i));
 		}
 	}
 }
@@ -6,8 +6,12 @@
 #include "Object.hpp" //!!This just includes World.hpp back, intentionally! :)
                       //!!(Wouldn't be that way if World::Body{} could just be defined there, separetely.)
 
-#include <memory>     // shared_ptr
+#include "Model/Math/Vector2Ref.hpp"
+#include "Model/GravityKernel.hpp"
+#include "Model/ParticlePool.hpp"
+
 #include <vector>
+#include <span>
 //!!No, not yet. It's just too cumbersome, for too little gain:
 //!!#include <optional> // for load()
 
@@ -42,7 +46,7 @@ namespace Model {
 // Origin: center of the screen (window, view pane...)
 
 
-static constexpr char const* VERSION = "0.1.4";
+static constexpr char const* VERSION = "0.1.5";
 
 //============================================================================
 class World // The model world
@@ -55,6 +59,7 @@ class World // The model world
 //----------------------------------------------------------------------------
 public:
 	static constexpr float CFG_GLOBE_RADIUS = 50000000.0f; // m
+	static constexpr unsigned MAX_STEP_LEVEL = 12; // Max. 4096 block time sub-steps per tick
 
 //----------------------------------------------------------------------------
 // API Types...
@@ -86,6 +91,24 @@ public:
 		UseDefault = unsigned(-1), //!! Not actually part of the value set (but an add-on type!), but C++...
 	};
 
+	enum class GravitySolver : unsigned {
+		Exact,     // The O(n²) pairwise loop (the regression tests depend on this one!)
+		BarnesHut, // O(n log n) quadtree approximation; accuracy set by bh_theta
+		FMM,       // O(n) multipole expansions; accuracy set by fmm_order (Hyperbolic only, BarnesHut otherwise)
+
+		Default = Exact,
+		UseDefault = unsigned(-1), //!! Not actually part of the value set (but an add-on type!), but C++...
+	};
+
+	enum class Integrator : unsigned {
+		Euler,          // Semi-implicit Euler: kick, then drift (the regression tests depend on this one!)
+		Leapfrog,       // Drift-kick-drift: 2nd order, still one force calc. per tick
+		VelocityVerlet, // Kick-drift-kick: 2nd order, needs the accel. from the prev. tick, too
+
+		Default = Euler,
+		UseDefault = unsigned(-1), //!! Not actually part of the value set (but an add-on type!), but C++...
+	};
+
 	//--------------------------------------------------------------------
 	struct Body //!! : public Serializable //! No: this would kill the C++ designated init syntax! :-/
 	                                       //! Also old-school; template-/concept-based approaches are superior.
@@ -154,6 +177,172 @@ public:
 		static bool load(std::istream&, World::Body* result = nullptr); // Verifies only (comparing to *this) if null
 	};
 
+	//--------------------------------------------------------------------
+	// The inputs and results of the last recalc() of a stored body, so it can
+	// skip what hasn't changed since (e.g. a touch only changes T, so the radius
+	// can stay, and the color, too, if it's the same at the new T).
+	// (The results are also checked, in case they have been changed directly.)
+	struct RecalcCache
+	{
+		Phys::Mass mass = 0;
+		Phys::Density density = 0;
+		Phys::Length r = 0;
+		Phys::Temperature T = 0;
+		uint32_t color = 0;
+		bool r_valid = false;
+		bool color_valid = false;
+	};
+
+	//--------------------------------------------------------------------
+	// Proxy ("view") of a body in the SoA storage (see BodyStore below),
+	// with the same fields (as references) and ops. as Body itself.
+	//! NOTE: Like iterators, these get invalidated by adding/removing bodies!
+	struct BodyRef
+	{
+		decltype(Body::superpower)& superpower;
+		Phys::Time& lifetime;
+		Phys::Length& r;
+		Phys::Density& density;
+		Math::Vector2Ref<NumType> p;
+		Math::Vector2Ref<NumType> v;
+		Phys::Temperature& T;
+		uint32_t& color;
+		Phys::Mass& mass;
+		Thruster& thrust_up;
+		Thruster& thrust_down;
+		Thruster& thrust_left;
+		Thruster& thrust_right;
+		RecalcCache& recalced;
+
+		operator Body() const; // Copy it out
+
+		void recalc();
+		bool can_expire() const noexcept { return lifetime > 0; }
+		void terminate()  noexcept { lifetime = 0; }
+		bool terminated() const noexcept { return lifetime == 0; }
+		void on_event(Event e, ...);
+
+		bool has_thruster() { return thrust_up.thrust_level() != Math::MyNaN<float>; }
+		void add_thrusters() {
+			thrust_up.thrust_level(0);
+			thrust_down.thrust_level(0);
+			thrust_left.thrust_level(0);
+			thrust_right.thrust_level(0);
+		}
+		bool is_player() { return has_thruster(); }
+	};
+
+	//--------------------------------------------------------------------
+	// Stable reference to a body: unlike its index, it stays valid as long as
+	// the body exists (while removing others may move it in the store), and it
+	// never refers to anything else later (even if its slot gets reused)
+	struct Handle
+	{
+		uint32_t slot = ~0u;
+		uint32_t generation = 0;
+
+		bool operator==(const Handle&) const = default;
+		explicit operator bool() const { return slot != ~0u; } // Not null (but may be stale!)
+	};
+	static constexpr size_t NoIndex = ~0u; //! Not ~size_t(0), but the same "none" the app uses!
+
+	//--------------------------------------------------------------------
+	// Structure-of-arrays storage of the bodies
+	//
+	// The "hot" fields (the ones the interaction loops crunch) are in
+	// separate contiguous arrays; the rest are stored as whole Body records
+	// (in `cold`), the hot fields of which are just unused (stale) there!
+	//
+	class BodyStore
+	{
+	public:
+		std::vector<NumType> px, py; // Phys::Position
+		std::vector<NumType> vx, vy; // Phys::Velocity
+		std::vector<Phys::Mass>   mass;
+		std::vector<Phys::Length> r;
+		std::vector<Phys::Time>   lifetime; // For skipping the terminated ones
+		std::vector<Phys::Temperature> T; // For the cooling (see World::update_before_interactions())
+		std::vector<decltype(Body::superpower)> superpower;
+		std::vector<NumType> ax, ay; // Accel. from the last tick (for VelocityVerlet; MyNaN: not known yet)
+		std::vector<uint8_t> step_level; // Block time step: dt / 2^level (see World_BlockSteps.cpp)
+		std::vector<RecalcCache> recalced; // See BodyRef::recalc()
+		std::vector<uint8_t> activity; // Activity flags (see below)
+		std::vector<Body> cold;
+
+		// The active subsets for the autogenic effects (see World::update_before_interactions()),
+		// as ascending index lists, so the rest of the bodies don't even need to be visited:
+		enum Activity : uint8_t {
+			Expiring  = 1, // can_expire()
+			Hot       = 2, // T > 0
+			Thrusting = 4, // has_thruster()
+			Changed   = 0x80, // Accessed via operator[] since the last update_activity()
+		};
+		std::vector<size_t> expiring, hot, thrusting;
+		//! The new bodies, and the ones accessed via operator[] (i.e. possibly changed
+		//! by the app) are only (re)classified by this (the rest are expected to be
+		//! kept up to date by the world itself), so call it before using the lists:
+		void update_activity();
+
+		size_t size()  const { return cold.size(); }
+		bool   empty() const { return cold.empty(); }
+		size_t capacity() const { return cold.capacity(); } // Same for all the arrays
+		void reserve(size_t n);
+		void reserve_more(size_t n); // Hint before adding n more (e.g. a burst of particles); grows geometrically
+		void clear();
+
+		// Allocation counters, to check that there's no heap traffic in the steady state:
+		struct Stats
+		{
+			size_t regrowths = 0; // Reallocations of the arrays (all of them at once)
+			size_t new_slots = 0; // Handle slots allocated (i.e. not reused)
+		};
+		const Stats& stats() const { return _stats; }
+
+		size_t push_back(const Body& obj); // Returns the index of the new body
+		void   erase(size_t ndx); //! O(1): moves the last body to `ndx`!
+		// Remove all the terminated bodies in one pass, keeping the order of the rest;
+		// returns their number (and their old indexes, ascending, if `removed`):
+		size_t erase_terminated(std::vector<size_t>* removed = nullptr);
+		// Rearrange the bodies from `first` on: the new k-th is the old order[k]th
+		// (a permutation of [first, size()), in place, keeping the handles valid):
+		void   reorder(const std::vector<size_t>& order, size_t first);
+
+		BodyRef operator[](size_t ndx);
+		BodyRef ref(size_t ndx); // Same, without flagging it Changed: only for the world's own updates keeping the lists right
+		Body    get(size_t ndx) const; // Copy of the body assembled from the arrays
+		bool    terminated(size_t ndx) const { return lifetime[ndx] == 0; }
+
+		// Slot map of the handles:
+		Handle handle(size_t ndx) const { return {_slot_of[ndx], _slots[_slot_of[ndx]].generation}; }
+		size_t index_of(Handle h) const { // NoIndex if stale (or null)
+			return h.slot < _slots.size() && _slots[h.slot].generation == h.generation
+			       ? _slots[h.slot].index : NoIndex; }
+		bool   valid(Handle h) const { return index_of(h) != NoIndex; }
+
+	protected:
+		template <typename F> void _for_each_array(F&& f) {
+			f(px); f(py); f(vx); f(vy); f(mass); f(r); f(lifetime); f(T); f(superpower); f(ax); f(ay); f(step_level); f(recalced); f(activity); f(cold);
+			f(_slot_of);
+		}
+
+		struct Slot
+		{
+			size_t   index;      // NoIndex if free
+			uint32_t generation; // Bumped on every release, invalidating the old handles
+		};
+		template <typename F> void _for_each_activity_list(F&& f) {
+			f(expiring, Expiring); f(hot, Hot); f(thrusting, Thrusting);
+		}
+		std::vector<size_t> _changed; // The bodies to reclassify (see update_activity())
+
+		std::vector<Slot>     _slots;
+		std::vector<uint32_t> _free_slots;
+		std::vector<uint32_t> _slot_of; // For each body
+
+		static constexpr size_t MIN_CAPACITY = 256;
+		Stats _stats;
+	};
+
 	//------------------------------------------------------------------------
 	// world init, ++world...
 	//--------
@@ -163,7 +352,37 @@ public:
 	void update(float dt, Szim::SimApp& app);
 	void update_before_interactions(float dt, Szim::SimApp& app);
 	void update_pairwise_interactions(float dt, Szim::SimApp& app);
+	void update_pairwise_interactions_BarnesHut(float dt, Szim::SimApp& app); // See BarnesHut.cpp
+	void update_pairwise_interactions_FMM(float dt, Szim::SimApp& app); // See FMM.cpp
+	void update_pairwise_interactions_SIMD(float dt, Szim::SimApp& app); // See GravityKernel.cpp
+	void update_pairwise_interactions_heavy(float dt, Szim::SimApp& app); // See GravityKernel.cpp
+	void update_pairwise_interactions_MT(float dt, Szim::SimApp& app); // See World_MT.cpp
+	void update_collisions_broadphase(Szim::SimApp& app); // See SpatialHash.cpp
 	void update_after_interactions(float dt, Szim::SimApp& app);
+	void update_block_steps(float dt, Szim::SimApp& app); // See World_BlockSteps.cpp
+
+	// The integrator steps around the pairwise pass (which still just adds dv to v):
+	void _integrate_before_interactions(float dt);
+	void _integrate_after_interactions(float dt);
+	// The mode the accel. in bodies.ax/ay comes from (and is kept up to date by):
+	enum class AccelOwner : uint8_t { None, VelocityVerlet, BlockSteps };
+	void _own_accelerations(AccelOwner mode); // Invalidates them, if set by another mode
+
+	// Set ax, ay of the targets for the block steps (+ get their interaction timescales):
+	void _block_accelerations(const std::vector<size_t>& targets, std::vector<NumType>& timescales, Szim::SimApp& app);
+
+	// The exact loop, specialized (see update_pairwise_interactions() for the selection):
+	template <GravityMode GM, LoopMode LM, bool IMMUNITY>
+	void _pairwise_loop(float dt, Szim::SimApp& app);
+
+	// Call the collision (and touch) hooks, like the exact loop does (for the other solvers):
+	void _collide(size_t target, size_t source, NumType distance, Szim::SimApp& app);
+
+	// Setup for the gravity kernel (see GravityKernel.cpp):
+	GravityKernel::Bodies _kernel_bodies();
+	void                  _kernel_commit(const GravityKernel::Bodies& b); // For the double build (see _kernel_bodies())
+	GravityKernel::Params _kernel_params(float dt) const;
+	GravityKernel::ISA    _kernel_isa() const;
 
 //----------------------------------------------------------------------------
 // API Ops...
@@ -172,7 +391,15 @@ public:
 	// partially initialized template obj as input:
 	size_t add_body(Body const& obj);
 	size_t add_body(Body&& obj);
-	void remove_body(size_t ndx);
+	size_t add_bodies(std::span<const Body> objs); // In one go; returns the index of the first one
+	void remove_body(size_t ndx); //! Moves the last body to `ndx` (see BodyStore::erase())!
+	size_t remove_terminated_bodies(std::vector<size_t>* removed = nullptr); // See BodyStore::erase_terminated()
+	// Sort the bodies (from `first`, e.g. after the players) along a Morton (Z-order)
+	// curve, for the locality of the interaction loops (see World_Reorder.cpp).
+	// The handles stay valid, but the indexes don't; `order` gets the old index
+	// of each body (at its new index), if not null:
+	void reorder_bodies(size_t first = 0, std::vector<size_t>* order = nullptr);
+	bool reorder_due() const { return reorder_interval && _ticks_since_reorder >= reorder_interval; }
 
 	bool is_colliding([[maybe_unused]] const Body* obj1, [[maybe_unused]] const Body* obj2)
 	// Takes the body shape into account.
@@ -182,10 +409,10 @@ public:
 		return false;
 	}
 
-	bool is_colliding(const Body* obj1, const Body* obj2, Phys::Length distance)
+	bool is_colliding(size_t ndx1, size_t ndx2, Phys::Length distance) const
 	// Only for circles yet!
 	{
-		return distance <= obj1->r + obj2->r; // false; // -> #526!
+		return distance <= bodies.r[ndx1] + bodies.r[ndx2]; // false; // -> #526!
 	}
 
 //----------------------------------------------------------------------------
@@ -198,15 +425,36 @@ public:
 //!!So just allow public access for now:
 public:
 	//!! REVISE _copy(), and save/load, WHENEVER CHANGING THE DATA HERE!
+	//!! (And assign_state(), too, but NOT for the processing options below!)
 	float friction = 0.03f; //!!Take its default from the cfg instead!
 	GravityMode gravity_mode;   //! v0.1.0
 	NumType gravity = Phys::G; //! v0.1.1 //!!Take its default from the cfg instead!
+	Integrator integrator; //! v0.1.5
 	bool  _interact_all = false; // Bodies react to each other too, or only the player(s)?
 	                             //!! Reconcile with interaction_mode!
 
-	std::vector< std::shared_ptr<Body> > bodies; //!! Can't just be made `atomic` by magic... (wouldn't even compile)
+	BodyStore bodies; //!! Can't just be made `atomic` by magic... (wouldn't even compile)
 
 	LoopMode loop_mode; // Not to be saved! (Not world state, but a processing option.)
+	GravitySolver gravity_solver; // Not to be saved either!
+	NumType bh_theta = 0.5f; // Barnes-Hut opening angle: smaller is more accurate (0: exact, but slower than the plain loop)
+	unsigned fmm_order = 12; // FMM expansion order: higher is more accurate (error ~ 0.55^order at worst)
+	bool  fmm_check = false; // Also do the direct sum with the FMM, and report the error (slow!)
+	bool  simd = false; // Use the SIMD kernel for the exact loop (not bit-exact with the scalar one in Half mode!)
+	NumType source_mass_ratio = 0; // Only the bodies at least this heavy (relative to the heaviest) pull the others (0: all)
+	bool  broadphase = false; // Find the collisions with a spatial hash (O(n)), not in the gravity loop (O(n²))
+	unsigned threads = 1; // Max. threads for the exact loop (0: all the job system has; not bit-exact with 1, but the same in every run)
+	unsigned max_step_level = 0; // Block time steps: up to 2^max_step_level gravity sub-steps per tick (0: off)
+	NumType step_eta = 0.03f; // Block time step accuracy: step <= step_eta * the body's shortest interaction timescale
+	unsigned reorder_interval = 0; // Ticks between the Morton reorderings of the bodies (see reorder_bodies(); 0: off)
+
+	ParticlePool particles; // The emitters' light-weight particles (not bodies; not saved either!)
+
+protected:
+	std::vector<NumType> _v_prev_x, _v_prev_y; // Velocities before the pairwise pass (for VelocityVerlet)
+	AccelOwner _accel_owner = AccelOwner::None; // See _own_accelerations()
+	unsigned _ticks_since_reorder = 0;
+public:
 
 //----------------------------------------------------------------------------
 // Service functions (C++ mechanics, persistence etc.)...
@@ -218,6 +466,7 @@ public:
 	//!!Say sg. about move, too! I guess they are inhibited by the above now.
 
 	void _copy(World const& other);
+	void assign_state(World const& other); // Only the saved state, keeping the processing options (for loading)
 
 	bool        save(std::ostream& out, const char* version = nullptr);
 	static bool load(std::istream& in, World* result = nullptr); //!!NOT YET: null means "Verify only" (comparing to *this)
@@ -228,6 +477,7 @@ public:
 
 //------------------------------------------------------------------------
 using Entity = World::Body;
+using EntityRef = World::BodyRef;
 
 
 } // namespace Model
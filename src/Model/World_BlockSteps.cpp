@@ -0,0 +1,211 @@
+// Must do this first for Tracy's winsock2.h has to precede any windows.h! :-/
+#include "extern/Tracy/public/tracy/Tracy.hpp"
+
+#include "Model/World.hpp"
+
+#include "Engine/SimApp.hpp" // jobs
+
+#include <vector>
+#include <cmath> // sqrt, ceil, log2
+#include <algorithm> // min
+#include <limits>
+
+
+namespace Model {
+
+using namespace std;
+
+//============================================================================
+void World::update_block_steps(float dt, Szim::SimApp& app)
+// Hierarchical (power-of-two) block time steps, for the gravity
+//
+// Every body has its own step of dt / 2^level (level in [0, max_step_level]),
+// set from the shortest timescale of its interactions (free-fall and fly-by
+// time with its "most pressing" neighbour), so only the ones in close/fast
+// encounters get sub-stepped, the rest just take one step per tick.
+//
+// Each body does kick-drift-kick (i.e. velocity Verlet) on its own step; the
+// drifts are done for all the bodies up to each step end (of any body), but the
+// forces are only calculated for the ones at the end of their step (directly
+// summing the pull of all the others, at their current positions). A body can
+// only switch to a longer step where that would also be aligned to the grid of
+// that level.
+//
+// The steps are all aligned to the grid of the finest allowed level, but only
+// the step ends of the levels actually in use are visited, so if every body is
+// at level 0, it's just one step per tick. (And, as all the deeper levels end
+// wherever a level ends, the bodies are kept in per-level lists, so the ones
+// ending a step can be collected without scanning all of them.)
+//
+// The collisions (the hooks) are still only checked once per tick, before the
+// sub-steps (see update_collisions_broadphase()), and the friction is also
+// applied once, at the end.
+//
+//! NOTE: The `integrator` and `gravity_solver` settings don't apply here!
+{
+ZoneScoped;
+	update_collisions_broadphase(app);
+	if (dt == 0.f) return;
+
+	const auto n = bodies.size();
+	const unsigned top = min(max_step_level, MAX_STEP_LEVEL);
+	const unsigned tick = 1u << top; // In the finest sub-steps (of the top level)
+	const NumType h = NumType(dt) / NumType(tick);
+	auto span = [top](unsigned level) { return 1u << (top - level); }; // Sub-steps per step
+
+	static vector<size_t> ending;  // Bodies at the end of their step (reused across ticks)
+	static vector<NumType> tscale; // Their interaction timescales
+	static vector<vector<size_t>> at_level; // The bodies at each level
+
+	// The level wanted for a timescale (and allowed at the `at`-th sub-step):
+	auto level_for = [&](NumType t, unsigned current, unsigned at) -> uint8_t {
+		unsigned wanted = 0;
+		if (auto ratio = NumType(dt) / (step_eta * t); ratio > 1)
+			wanted = ratio >= NumType(tick) ? top : unsigned(ceil(log2(ratio)));
+		// Only to a longer step that's also aligned here:
+		while (wanted < current && at % span(wanted) != 0) ++wanted;
+		return uint8_t(wanted);
+	};
+
+	// Bodies without an accel. yet (new, just loaded, or the other modes ran
+	// before; see _own_accelerations()), and the ones above the current top
+	// level need a fresh start:
+	ending.clear();
+	for (size_t i = 0; i < n; ++i) {
+		if (bodies.step_level[i] > top) bodies.step_level[i] = uint8_t(top);
+		if (bodies.ax[i] == Math::MyNaN<NumType>) ending.push_back(i);
+	}
+	if (!ending.empty()) {
+		_block_accelerations(ending, tscale, app);
+		for (size_t k = 0; k < ending.size(); ++k)
+			bodies.step_level[ending[k]] = level_for(tscale[k], top, 0);
+	}
+
+	at_level.resize(top + 1);
+	for (auto& list : at_level) list.clear();
+	for (size_t i = 0; i < n; ++i) at_level[bodies.step_level[i]].push_back(i);
+
+	// Starting kicks (everyone starts a step here):
+	for (size_t i = 0; i < n; ++i) {
+		auto half_step = h * NumType(span(bodies.step_level[i])) / 2;
+		bodies.vx[i] += bodies.ax[i] * half_step;
+		bodies.vy[i] += bodies.ay[i] * half_step;
+	}
+
+	for (unsigned s = 0; s < tick;)
+	{
+		// The next step end is that of the deepest level in use:
+		unsigned deepest = top;
+		while (deepest > 0 && at_level[deepest].empty()) --deepest;
+		auto next = s + span(deepest);
+
+		// Drift everyone there:
+		const auto tau = h * NumType(next - s);
+		for (size_t i = 0; i < n; ++i) {
+			bodies.px[i] += bodies.vx[i] * tau;
+			bodies.py[i] += bodies.vy[i] * tau;
+		}
+		s = next;
+
+		// The levels ending a step here (all the deeper ones end where a level ends):
+		unsigned first = deepest;
+		while (first > 0 && s % span(first - 1) == 0) --first;
+		ending.clear();
+		for (auto l = first; l <= deepest; ++l) {
+			ending.insert(ending.end(), at_level[l].begin(), at_level[l].end());
+			at_level[l].clear();
+		}
+
+		// Closing kicks, with the new accel., and then the starting kicks of
+		// the next steps (on their new levels; those can't be above `first`):
+		_block_accelerations(ending, tscale, app);
+		for (size_t k = 0; k < ending.size(); ++k) {
+			auto i = ending[k];
+			auto half_step = h * NumType(span(bodies.step_level[i])) / 2;
+			bodies.vx[i] += bodies.ax[i] * half_step;
+			bodies.vy[i] += bodies.ay[i] * half_step;
+			bodies.step_level[i] = level_for(tscale[k], bodies.step_level[i], s);
+			at_level[bodies.step_level[i]].push_back(i);
+			if (s < tick) {
+				half_step = h * NumType(span(bodies.step_level[i])) / 2;
+				bodies.vx[i] += bodies.ax[i] * half_step;
+				bodies.vy[i] += bodies.ay[i] * half_step;
+			}
+		}
+	}
+
+	// Friction:
+	for (size_t i = 0; i < n; ++i) {
+		bodies.vx[i] -= bodies.vx[i] * NumType(friction) * NumType(dt);
+		bodies.vy[i] -= bodies.vy[i] * NumType(friction) * NumType(dt);
+	}
+}
+
+//----------------------------------------------------------------------------
+void World::_block_accelerations(const vector<size_t>& targets, vector<NumType>& timescales, Szim::SimApp& app)
+// Set the accel. (ax, ay) of the targets from the pull of all the others (with
+// the "proper" force laws, like BarnesHut.cpp), and return their shortest
+// interaction timescales, too.
+//
+// Pairs in contact don't pull each other (like in the exact loop), and if
+// !_interact_all, only the player (#0) is interacting with the rest.
+{
+ZoneScoped;
+	using enum GravityMode;
+	static constexpr NumType NONE = numeric_limits<NumType>::max();
+
+	timescales.resize(targets.size());
+
+	const bool realistic = gravity_mode != Hyperbolic; // Experimental is the same as Realistic for now
+	const bool reacting_player = loop_mode == LoopMode::Half; // The player (as the source) is pulled back
+	const auto n = bodies.size();
+
+	auto sum_for = [&](size_t k) {
+		const auto t = targets[k];
+		NumType ax = 0, ay = 0, tmin = NONE;
+
+		if (gravity_mode != Off && !bodies.terminated(t)) {
+			const bool all_sources = _interact_all || (t == 0 && reacting_player);
+			for (size_t s = 0; s < (all_sources ? n : min(n, size_t(1))); ++s) {
+				if (s == t || bodies.terminated(s)) continue;
+
+				auto dx = bodies.px[s] - bodies.px[t],
+				     dy = bodies.py[s] - bodies.py[t];
+				auto distance = Math::mag2(dx, dy);
+				if (is_colliding(t, s, distance)) continue;
+
+				auto a = gravity * bodies.mass[s] / (distance * distance);
+				if (realistic) a /= distance;
+				ax += dx * a;
+				ay += dy * a;
+
+				// Free-fall time: sqrt(d / accel. of the pair)...
+				auto a_pair = gravity * (bodies.mass[s] + bodies.mass[t]) / (distance * distance);
+				if (!realistic) a_pair *= distance;
+				tmin = min(tmin, sqrt(distance / a_pair));
+				// ...and fly-by time:
+				auto dvx = bodies.vx[s] - bodies.vx[t],
+				     dvy = bodies.vy[s] - bodies.vy[t];
+				if (auto v = Math::mag2(dvx, dvy); v > 0) tmin = min(tmin, distance / v);
+			}
+			if (bodies.superpower[t].gravity_immunity) ax = ay = 0;
+		}
+
+		bodies.ax[t] = ax;
+		bodies.ay[t] = ay;
+		timescales[k] = tmin;
+	};
+
+	// Each target only writes its own data, so it's safe (and deterministic) to
+	// spread them over the workers:
+	static constexpr size_t MT_MIN_TARGETS = 64;
+	if (threads != 1 && targets.size() >= MT_MIN_TARGETS) {
+		app.jobs.parallel_for("block step forces", targets.size(), 16,
+			[&](size_t first, size_t last) { for (auto k = first; k < last; ++k) sum_for(k); },
+			threads);
+	} else {
+		for (size_t k = 0; k < targets.size(); ++k) sum_for(k);
+	}
+}
+
+} // namespace Model
@@ -0,0 +1,156 @@
+// Must do this first for Tracy's winsock2.h has to precede any windows.h! :-/
+#include "extern/Tracy/public/tracy/Tracy.hpp"
+
+#include "Model/World.hpp"
+
+#ifndef DISABLE_THREADS
+
+#include "Model/GravityKernel.hpp"
+#include "Engine/SimApp.hpp" // The interaction hooks
+
+#include <vector>
+#include <algorithm> // sort, min, max
+
+
+namespace Model {
+
+using namespace std;
+
+namespace {
+	struct Collision { size_t target, source; float distance; };
+}
+
+
+//============================================================================
+void World::update_pairwise_interactions_MT(float dt, Szim::SimApp& app)
+// Same as the exact loop (via the gravity kernel, see update_pairwise_interactions_SIMD),
+// but the (source, target) matrix is cut into square tiles, which are then dealt
+// out in a fixed number of groups (of consecutive tiles) to the workers of the
+// app's job system.
+//
+// Every group adds its dv-s to its own accumulators (so the symmetric updates of
+// the Half mode don't need any locking), covering only the range of bodies its
+// tiles can change, which are then summed up at the end, always in the group
+// order. (In the Full mode only the targets change, so the tiles go in column
+// order there, to keep those ranges short.) So, while the result is not
+// bit-exact with the exact loop (the summation order differs), it's still the
+// same from run to run (and with any number of threads), i.e. not depending on
+// which worker happens to get which group. The collisions are also just
+// collected in the groups, and the hooks are only called afterwards, from this
+// thread (in the same order as the exact loop would do).
+//
+//! NOTE: So the hooks see the velocities of the end of the tick, and changes done
+//!       by them (like to the radius) can't affect the rest of the tick!
+{
+ZoneScoped;
+	using namespace GravityKernel;
+
+	// Bodies per side of a tile: all the data the kernel reads for both sides
+	// (8 floats per body) should fit in the L1 (or at least L2) cache:
+	static constexpr size_t TILE = 256;
+	// Tile groups (and velocity accumulators): fixed (not the number of workers),
+	// for the same summation order in every run; enough to keep all the cores busy:
+	static constexpr size_t GROUPS = 32;
+
+	struct Group {
+		size_t first_tile, last_tile; // [first, last)
+		size_t v_first, v_end;        // The bodies its tiles can change: [first, end)
+		vector<float> acc_vx, acc_vy; // Their dv-s (from v_first)
+		vector<Collision> collisions;
+	};
+	static vector<Group> groups;               // (Reused across ticks)
+	static vector<pair<size_t, size_t>> tiles; // (source block, target block)
+
+	auto& jobs = app.jobs;
+	const auto isa = _kernel_isa();
+	const auto b = _kernel_bodies();
+	const auto p = _kernel_params(dt);
+	const auto n = b.count;
+
+	const size_t blocks = (n + TILE - 1) / TILE;
+	tiles.clear();
+	if (p.half) {
+		for (size_t sb = 0; sb < blocks; ++sb)
+			for (size_t tb = sb; tb < blocks; ++tb) tiles.push_back({sb, tb});
+	} else {
+		for (size_t tb = 0; tb < blocks; ++tb)
+			for (size_t sb = 0; sb < blocks; ++sb) tiles.push_back({sb, tb});
+	}
+
+	// Consecutive tiles (about the same number in each group):
+	groups.resize(min(GROUPS, tiles.size()));
+	for (size_t g = 0; g < groups.size(); ++g) {
+		auto& grp = groups[g];
+		grp.first_tile = tiles.size() * g / groups.size();
+		grp.last_tile = tiles.size() * (g + 1) / groups.size();
+		size_t lo = blocks, hi = 0; // Blocks
+		for (auto k = grp.first_tile; k < grp.last_tile; ++k) {
+			auto [s_block, t_block] = tiles[k];
+			lo = min(lo, p.half ? min(s_block, t_block) : t_block);
+			hi = max(hi, p.half ? max(s_block, t_block) : t_block);
+		}
+		grp.v_first = lo * TILE;
+		grp.v_end = min(n, (hi + 1) * TILE);
+	}
+
+	CollisionFn on_collision = broadphase ? nullptr // Already done
+	: +[](void* ctx, size_t target, size_t source, float distance) {
+		((vector<Collision>*)ctx)->push_back({target, source, distance});
+	};
+
+	auto run_group = [&](size_t g) {
+		auto& grp = groups[g];
+		grp.acc_vx.assign(grp.v_end - grp.v_first, 0.f);
+		grp.acc_vy.assign(grp.v_end - grp.v_first, 0.f);
+		auto& hits = grp.collisions; hits.clear();
+
+		auto tb = b; // Same bodies, but with this group's velocity accumulators
+		tb.vx = grp.acc_vx.data();
+		tb.vy = grp.acc_vy.data();
+		tb.v_first = grp.v_first;
+
+		for (auto k = grp.first_tile; k < grp.last_tile; ++k) {
+			auto [s_block, t_block] = tiles[k];
+			size_t s_end = min(n, (s_block + 1) * TILE),
+			       t_first = t_block * TILE, t_end = min(n, (t_block + 1) * TILE);
+
+			for (size_t s = s_block * TILE; s < s_end; ++s) {
+				if (!b.alive[s]) continue;
+				if (s_block != t_block) {
+					sweep(isa, tb, p, s, t_first, t_end, on_collision, &hits);
+				} else if (p.half) {
+					sweep(isa, tb, p, s, s + 1, t_end, on_collision, &hits);
+				} else {
+					sweep(isa, tb, p, s, t_first, s, on_collision, &hits);
+					sweep(isa, tb, p, s, s + 1, t_end, on_collision, &hits);
+				}
+			}
+		}
+	};
+	jobs.parallel_for("Interaction tiles", groups.size(), 1, [&](size_t first, size_t last) {
+		for (auto g = first; g < last; ++g) run_group(g);
+	}, threads);
+
+	// Sum up the accumulators (in the group order, for every body; only where they have any)...
+	jobs.parallel_for("Reduce dv", n, 4096, [&](size_t first, size_t last) {
+		for (const auto& grp : groups) {
+			for (size_t i = max(first, grp.v_first); i < min(last, grp.v_end); ++i) {
+				bodies.vx[i] += grp.acc_vx[i - grp.v_first];
+				bodies.vy[i] += grp.acc_vy[i - grp.v_first];
+			}
+		}
+	}, threads);
+
+	// ...and call the hooks for the collisions, in the order of the exact loop:
+	static vector<Collision> all;
+	all.clear();
+	for (auto& grp : groups) all.insert(all.end(), grp.collisions.begin(), grp.collisions.end());
+	sort(all.begin(), all.end(), [](auto& a, auto& b) {
+		return a.source != b.source ? a.source < b.source : a.target < b.target;
+	});
+	for (auto& c : all) _collide(c.target, c.source, c.distance, app);
+}
+
+} // namespace Model
+
+#endif // DISABLE_THREADS
@@ -0,0 +1,119 @@
+// Must do this first for Tracy's winsock2.h has to precede any windows.h! :-/
+#include "extern/Tracy/public/tracy/Tracy.hpp"
+
+#include "Model/World.hpp"
+
+#include <vector>
+#include <algorithm> // sort, min, max
+#include <numeric> // iota
+#include <limits>
+#include <cstdint>
+#include <utility> // pair, move
+#include <cassert>
+
+
+namespace Model {
+
+using namespace std;
+
+namespace {
+	// Interleave the bits of x and y (16 each) into a Z-order curve index:
+	uint32_t morton(uint32_t x, uint32_t y)
+	{
+		auto spread = [](uint32_t v) {
+			v &= 0xffff;
+			v = (v | (v << 8)) & 0x00ff00ff;
+			v = (v | (v << 4)) & 0x0f0f0f0f;
+			v = (v | (v << 2)) & 0x33333333;
+			v = (v | (v << 1)) & 0x55555555;
+			return v;
+		};
+		return spread(x) | (spread(y) << 1);
+	}
+}
+
+//============================================================================
+void World::reorder_bodies(size_t first, vector<size_t>* order)
+// The emitters keep appending their particles (all near the player) to the end
+// of the store, while the older bodies drift apart, so after a while the index
+// order has nothing to do with the positions any more, and then the broadphase,
+// the tree builders etc. keep jumping all over the arrays. Sorting them along a
+// Z-order curve puts the nearby bodies next to each other again.
+//
+//! Changes the summation order of the exact loop, too, so it's not bit-exact
+//! with the unsorted runs (that's why it's off by default; see reorder_interval).
+{
+ZoneScoped;
+	_ticks_since_reorder = 0;
+
+	static vector<size_t> order_here; // Reused, if the caller doesn't need it
+	if (!order) order = &order_here;
+
+	const auto n = bodies.size();
+	order->resize(n);
+	iota(order->begin(), order->end(), size_t(0));
+	if (first + 1 >= n) return;
+
+	// Quantize the positions in their bounding box (square, to keep the curve isotropic)...
+	NumType x_min = numeric_limits<NumType>::max(), y_min = x_min;
+	NumType x_max = numeric_limits<NumType>::lowest(), y_max = x_max;
+	for (size_t i = first; i < n; ++i) {
+		x_min = min(x_min, bodies.px[i]); x_max = max(x_max, bodies.px[i]);
+		y_min = min(y_min, bodies.py[i]); y_max = max(y_max, bodies.py[i]);
+	}
+	auto side = max(x_max - x_min, y_max - y_min);
+	auto scale = side > 0 ? NumType(0xffff) / side : NumType(0);
+
+	// ...and sort by their curve index (then by the old index, for determinism):
+	static vector<pair<uint32_t, size_t>> keys; // Reused across calls
+	keys.clear();
+	for (size_t i = first; i < n; ++i) {
+		keys.emplace_back(morton(uint32_t((bodies.px[i] - x_min) * scale),
+		                         uint32_t((bodies.py[i] - y_min) * scale)), i);
+	}
+	sort(keys.begin(), keys.end());
+
+	for (size_t k = 0; k < keys.size(); ++k) (*order)[first + k] = keys[k].second;
+	bodies.reorder(*order, first);
+}
+
+//----------------------------------------------------------------------------
+void World::BodyStore::reorder(const vector<size_t>& order, size_t first)
+{
+	const auto n = size();
+	assert(order.size() == n);
+
+	// Permute each array in place, cycle by cycle (so no realloc. either):
+	static vector<uint8_t> done;
+	_for_each_array([&](auto& a) {
+		done.assign(n, 0);
+		for (size_t s = first; s < n; ++s) {
+			if (done[s]) continue;
+			done[s] = 1;
+			if (order[s] == s) continue;
+			auto tmp = std::move(a[s]);
+			auto k = s;
+			for (auto src = order[k]; src != s; src = order[k]) {
+				a[k] = std::move(a[src]);
+				k = src;
+				done[k] = 1;
+			}
+			a[k] = std::move(tmp);
+		}
+	});
+
+	// The handles follow their bodies...
+	for (size_t k = first; k < n; ++k) _slots[_slot_of[k]].index = k;
+
+	// ...and so do the index lists (which then need to be sorted again):
+	static vector<size_t> new_index;
+	new_index.resize(n);
+	for (size_t k = 0; k < n; ++k) new_index[order[k]] = k;
+	_for_each_activity_list([&](auto& list, auto) {
+		for (auto& i : list) i = new_index[i];
+		sort(list.begin(), list.end());
+	});
+	for (auto& i : _changed) i = new_index[i];
+}
+
+} // namespace Model
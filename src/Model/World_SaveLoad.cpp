@@ -54,6 +54,8 @@ bool World::save(std::ostream& out, [[maybe_unused]] const char* version/* = nul
 		{ out << "gravity_mode = " << (unsigned)gravity_mode << '\n'; }
 	if (saved_version >= semver::version("0.1.2"))
 		{ out << "gravity_strength = " << gravity << '\n'; }
+	if (saved_version >= semver::version("0.1.5"))
+		{ out << "integrator = " << (unsigned)integrator << '\n'; }
 
 //!!This should go to session files, along with other app-level data (like view scale etc.)!
 //!!	if (saved_version >= semver::version("0.1.3"))
@@ -66,7 +68,7 @@ bool World::save(std::ostream& out, [[maybe_unused]] const char* version/* = nul
 		out << ndx << " : " // not "=" in order to assist load() a bit...
 		                    // Also, the space is needed before the ':' to allow reading the index (even into an int)!
 		<< "\"";
-			if (!bodies[ndx]->save(out)) {
+			if (!bodies.get(ndx).save(out)) {
 				return false;
 			}
 		out << "\"" << '\n'; //! For *some* readability. (Whitespace will be skipped after the bin chunk.)
@@ -139,6 +141,10 @@ cerr << "DBG> World::load: gravity_mode = " << (unsigned)w_new.gravity_mode << '
 			{ ++_prop_ndx_; w_new.gravity = stof(props["gravity_strength"]);
 //cerr << "DBG> gravity strength after load: " << w_new.gravity << '\n';
 			}
+		if (loaded_version >= semver::version("0.1.5"))
+			{ ++_prop_ndx_; w_new.integrator = (Integrator)stoul(props["integrator"]);
+			  if (w_new.integrator > Integrator::VelocityVerlet) throw "Unknown integrator";
+			}
 	} catch (...) {
 		cerr << "- ERROR: Invalid (type of) property #"<<_prop_ndx_<<" in the loaded snapshot.\n";
 		return false;
@@ -1,9 +1,18 @@
 ﻿#ifndef _CVBD70MM479T6ND39F567MTNNH587D45F8_
 #define _CVBD70MM479T6ND39F567MTNNH587D45F8_
 
+// Cube root w/o pow() for the radius in Body::recalc() (see Math::cbrt_fast()).
+//! Off by default, as the radii differ in the last bits, so the regression tests
+//! would fail (they are saved, too):
+//#define MODEL_FAST_CBRT
+
 namespace Model {
 
+#ifdef MODEL_DOUBLE // Build option (PRECISION=double)
+	using BasicNumberType = double;
+#else
 	using BasicNumberType = float;
+#endif
 
 }
 
@@ -20,6 +20,8 @@
 	using std::pow;
 #include <iostream>
 	using std::cerr, std::endl;
+#include <fstream>
+	using std::ifstream;
 #include <cassert>
 #include "sz/DBG.hh"
 
@@ -66,11 +68,10 @@ ZoneScoped;
 	avatars.emplace_back(Avatar{ .image_path = "image/KittyGod.jpg"});
 	tx_kittygod = avatars.size() - 1;
 
-	//!! OMG, also the cringefest!... The view.reset() below is needed to sync the view._avatars list with the "real" avatars,
-	//!! which is -- alas, counterintuitively! -- expected by (something in) add_entity(), I guess! :-o :-/
-	//!! -> WHICH SHOULD BE FIXED, MOST LIKELY!
-cerr << "DBG> Right after loading the avatar images (in "<<__FUNCTION__<<"):\n";
-	oon_main_view().reset(); //!!REPLACE THIS WITH A SANER WAY TO SYNC THE VIEW TO THE APP STATE (i.e. the avatars)!
+	// Sync the view's avatar images with the "real" avatars, once and for all
+	// (before any drawing, which may happen in another thread later):
+	oon_main_view().load_avatars();
+	oon_main_view().reset();
 
 	//!!
 	//!! MOVE THIS TO SimApp! But can't yet be, as the stupid avatar loading must happen first! :-o
@@ -127,7 +128,7 @@ cerr << "DBG> Right after loading the avatar images (in "<<__FUNCTION__<<"):\n";
 	}
 
 	// Focus on Player #1:
-	focused_entity_ndx = player_entity_ndx(1); //!!... See init_world_hook()!
+	focus_entity(player_entity_ndx(1)); //!!... See init_world_hook()!
 
 	//!! Absolutlely MUST come after the world init (i.e. session loading!)
 	//!! Also: the widgets are only (or mostly) initialized from prior app state, and not updated by (most)
@@ -174,6 +175,54 @@ void OONApp::done() //override
 	if (args["session"]) { // If empty and no --session-save-as, it will be saved as "UNNAMED.autosave" or sg. like that.
 		session.close();
 	}
+
+	// Check the final state against a reference save (for regression tests
+	// of the double/mixed builds, which can't be bit-exact with the float one):
+	if (args["compare-with"]) { // --compare-with=<state file> [--compare-tolerance=<relative error>]
+		float tolerance = 1e-3f;
+		try { tolerance = std::stof(args("compare-tolerance")); } catch(...){}
+		if (!compare_with_reference(args("compare-with"), tolerance)) {
+			request_exit(1);
+		}
+	}
+}
+
+//----------------------------------------------------------------------------
+bool OONApp::compare_with_reference(const string& fname, float tolerance)
+// The max. deviation of the body positions and velocities is measured relative
+// to the RMS magnitude of those in the reference (so a few bodies near the
+// origin, or at rest, won't blow it up).
+{
+	ifstream file(fname, ios::binary); //! Only uncompressed saves (--no-save-compressed) are supported!
+	World ref;
+	if (!file || !World::load(file, &ref)) {
+		cerr << "- ERROR: Couldn't load the reference state from \"" << fname << "\"!\n";
+		return false;
+	}
+
+	const auto& bodies = const_world().bodies;
+	if (bodies.size() != ref.bodies.size()) {
+		cerr << "- Body count differs from the reference: " << bodies.size() << " vs. " << ref.bodies.size() << "\n";
+		return false;
+	}
+
+	double p_rms = 0, v_rms = 0, p_maxdiff = 0, v_maxdiff = 0;
+	for (size_t i = 0; i < bodies.size(); ++i) {
+		p_rms += double(ref.bodies.px[i]) * ref.bodies.px[i] + double(ref.bodies.py[i]) * ref.bodies.py[i];
+		v_rms += double(ref.bodies.vx[i]) * ref.bodies.vx[i] + double(ref.bodies.vy[i]) * ref.bodies.vy[i];
+		p_maxdiff = max(p_maxdiff, std::hypot(double(bodies.px[i]) - ref.bodies.px[i], double(bodies.py[i]) - ref.bodies.py[i]));
+		v_maxdiff = max(v_maxdiff, std::hypot(double(bodies.vx[i]) - ref.bodies.vx[i], double(bodies.vy[i]) - ref.bodies.vy[i]));
+	}
+	if (bodies.size()) {
+		p_rms = std::sqrt(p_rms / bodies.size());
+		v_rms = std::sqrt(v_rms / bodies.size());
+	}
+	auto p_err = p_rms > 0 ? p_maxdiff / p_rms : p_maxdiff;
+	auto v_err = v_rms > 0 ? v_maxdiff / v_rms : v_maxdiff;
+
+	cerr << "Max. deviation from the reference (relative to its RMS): position " << p_err << ", velocity " << v_err
+	     << " (tolerance: " << tolerance << ")\n";
+	return p_err <= tolerance && v_err <= tolerance;
 }
 
 void OONApp::init_world_hook() //override
@@ -221,7 +270,51 @@ cerr << "DBG> Creating two small moons by default...\n";
 		}; if (args["friction"]) {
 			float f = stof(args("friction"));
 			world().friction = f;
-		};
+		}; if (appcfg.get("sim/barnes_hut", false)) {
+			w.gravity_solver = World::GravitySolver::BarnesHut;
+		}; w.bh_theta = appcfg.get("sim/barnes_hut_theta", w.bh_theta);
+		   if (args["barnes-hut"]) { // --barnes-hut[=theta]
+			w.gravity_solver = World::GravitySolver::BarnesHut;
+			if (!args("barnes-hut").empty()) w.bh_theta = stof(args("barnes-hut"));
+		}; if (appcfg.get("sim/fmm", false)) {
+			w.gravity_solver = World::GravitySolver::FMM;
+		}; w.fmm_order = appcfg.get("sim/fmm_order", w.fmm_order);
+		   if (args["fmm"]) { // --fmm[=order]
+			w.gravity_solver = World::GravitySolver::FMM;
+			if (!args("fmm").empty()) w.fmm_order = stoi(args("fmm"));
+		}; if (args["fmm-check"]) {
+			w.fmm_check = true;
+		}; if (appcfg.get("sim/simd", false) || args["simd"]) {
+			w.simd = true;
+		}; w.source_mass_ratio = appcfg.get("sim/gravity_source_mass_ratio", w.source_mass_ratio);
+		   if (args["heavy-sources"]) { // --heavy-sources[=mass_ratio]
+			w.source_mass_ratio = args("heavy-sources").empty() ? 0.001f : stof(args("heavy-sources"));
+		}; if (appcfg.get("sim/broadphase", false) || args["broadphase"]) {
+			w.broadphase = true;
+		}; if (auto name = args["integrator"] ? args("integrator") : appcfg.get("sim/integrator", ""); !name.empty()) {
+			if      (name == "euler")    w.integrator = World::Integrator::Euler;
+			else if (name == "leapfrog") w.integrator = World::Integrator::Leapfrog;
+			else if (name == "verlet")   w.integrator = World::Integrator::VelocityVerlet;
+			else cerr << "- WARNING: Unknown integrator \"" << name << "\" ignored!\n";
+		}; w.max_step_level = appcfg.get("sim/block_steps", w.max_step_level);
+		   w.step_eta = appcfg.get("sim/block_step_eta", w.step_eta);
+		   if (args["block-steps"]) { // --block-steps[=max_level]
+			w.max_step_level = args("block-steps").empty() ? 8 : stoi(args("block-steps"));
+		}; w.threads = appcfg.get("sim/threads", w.threads);
+		   if (args["threads"]) { // 0: all cores
+			w.threads = stoi(args("threads"));
+		}; w.reorder_interval = appcfg.get("sim/reorder_interval", w.reorder_interval);
+		   if (args["reorder"]) { // --reorder[=ticks]
+			w.reorder_interval = args("reorder").empty() ? 100 : stoi(args("reorder"));
+		}; if (args["light-particles"]) {
+			appcfg.light_particles = true;
+		}; if (args["batched"]) {
+			appcfg.batched_rendering = true;
+		}; if (args["render-thread"]) {
+			appcfg.render_thread = true;
+		}; w.particles.set_capacity(appcfg.get("sim/particle_pool_size", unsigned(w.particles.capacity())));
+		   w.particles.gravity = appcfg.get("sim/particle_gravity", w.particles.gravity);
+		   w.particles.source_mass_ratio = appcfg.get("sim/particle_gravity_mass_ratio", w.particles.source_mass_ratio);
 	} catch(...) {
 		cerr << __FUNCTION__ << ": ERROR processing/applying some cmdline args!\n";
 		request_exit(-1);
@@ -230,19 +323,6 @@ cerr << "DBG> Creating two small moons by default...\n";
 }
 
 
-//----------------------------------------------------------------------------
-// (Unrelated to onResize(), but... where else would be better to put these...)
-void OONApp::resize_shapes(float factor) //override
-{
-	oon_main_view().resize_objects(factor);
-}
-
-void OONApp::resize_shape(size_t ndx, float factor) //override
-{
-	oon_main_view().resize_object(ndx, factor);
-}
-
-
 //----------------------------------------------------------------------------
 unsigned OONApp::add_player(World::Body&& obj, Avatar& avatar, VirtualController& ctrlr) //override
 {
@@ -382,7 +462,7 @@ void OONApp::pan_reset()
 	//!!?? What is the rule for Scroll Lock in this case?
 	//!!The key should be turned off!...
 	//!!
-	focused_entity_ndx = ~0u; //!!... Whoa! :-o See updates_for_next_frame()!
+	focus_entity(~0u); //!!... Whoa! :-o See updates_for_next_frame()!
 }
 
 void OONApp::pan(Vector2f delta) { oon_main_camera().pan_x(delta.x); oon_main_camera().pan_y(delta.y); }
@@ -391,7 +471,7 @@ void OONApp::pan_y(float delta)  { oon_main_camera().pan_y(delta); }
 
 void OONApp::pan_to_center(size_t entity_id)
 {
-	oon_main_camera().center_to(Vector2f(entity(entity_id).p));
+	oon_main_camera().center_to(Vector2f(const_entity(entity_id).p));
 	oon_main_camera().focus_to({0, 0});
 //!!??	oon_main_camera().focus_to(entity(id).p);
 }
@@ -403,7 +483,7 @@ void OONApp::center_player(unsigned player_id)
 
 void OONApp::pan_to_focus(size_t id)
 {
-	auto vpos = oon_main_camera().world_to_view_coord(Vector2f(entity(id).p));
+	auto vpos = oon_main_camera().world_to_view_coord(Vector2f(const_entity(id).p));
 	oon_main_camera().pan(vpos - oon_main_camera().focus_offset);
 }
 
@@ -417,23 +497,15 @@ void OONApp::follow_player(unsigned player_id)
 
 void OONApp::zoom_reset()
 {
-	//! Can't just call oon_main_camera().reset_zoom(): we need to adjust the cached shapes, too!
-
-	auto old_scale = oon_main_camera().scale(); // See below why this is needed...
-
+	//! The view derives the on-screen sizes from the camera scale, at draw time,
+	//! so nothing else to adjust here.
 	oon_main_camera().reset_zoom();
-
-	//!! Alas, no direct (abs.) (re)set_scale method for this:
-	resize_shapes(oon_main_camera().scale()/old_scale); // Adjust scaling (relative to current level)
-	//!! (Also can't just trivially call zoom(...) here either, as the two zoom levels would go out of sync.)
 }
 
 void OONApp::zoom(float factor)
 {
 	//!!?? if (!factor) factor = 1.0f; //! 0 makes 0 sense, so...
-	oon_main_camera().zoom(factor);
-	resize_shapes(factor); // Adjust scaling (relative to current level)
-	//!!scale_shapes(level); // Set scaling (abs. level)
+	oon_main_camera().zoom(factor); // (The shapes get scaled to this at draw time.)
 }
 // These can't call oon_main_camera().zoom_in/out directly either, because we need to trigger our zoom_hook!...
 void OONApp::zoom_in (float amount) { zoom(1.f + amount); }
@@ -600,11 +672,11 @@ void OONApp::toggle_sound_fx() { backend.audio.toggle_sounds(); }
 
 
 //----------------------------------------------------------------------------
-void OONApp::undirected_interaction_hook(Model::World* w, Entity* obj1, Entity* obj2, float dt, double distance, ...) //override
+void OONApp::undirected_interaction_hook(Model::World* w, EntityRef obj1, EntityRef obj2, float dt, double distance, ...) //override
 {w, obj1, obj2, dt, distance;
 }
 
-void OONApp::directed_interaction_hook(Model::World* w, Entity* source, Entity* target, float dt, double distance, ...) //override
+void OONApp::directed_interaction_hook(Model::World* w, EntityRef source, EntityRef target, float dt, double distance, ...) //override
 {w, source, target, dt, distance;
 //	if (!obj1->is_player())
 //		obj1->color += 0x3363c3;
@@ -630,17 +702,17 @@ void OONApp::directed_interaction_hook(Model::World* w, Entity* source, Entity*
 }
 
 //----------------------------------------------------------------------------
-bool OONApp::touch_hook(World* w, World::Body* obj1, World::Body* obj2)
+bool OONApp::touch_hook(World* w, EntityRef obj1, EntityRef obj2)
 {w;
-	if (obj1->is_player() || obj2->is_player()) {
+	if (obj1.is_player() || obj2.is_player()) {
 		backend.audio.play_sound(snd_clack);
 	}
 
-	obj1->T += 100;
-	obj2->T += 100;
+	obj1.T += 100;
+	obj2.T += 100;
 
-	obj1->recalc();
-	obj2->recalc();
+	obj1.recalc();
+	obj2.recalc();
 
 	return false; //!!Not yet used!
 }
@@ -650,7 +722,11 @@ bool OONApp::touch_hook(World* w, World::Body* obj1, World::Body* obj2)
 //----------------------------------------------------------------------------
 void OONApp::add_random_bodies_near(size_t base_ndx, size_t n)
 {
-	while (n--) add_random_body_near(base_ndx);
+	static std::vector<Entity> batch; // Reused
+	batch.clear();
+	batch.reserve(n);
+	while (n--) batch.push_back(random_body_near(base_ndx));
+	add_entities(batch);
 }
 
 //----------------------------------------------------------------------------
@@ -665,24 +741,19 @@ void OONApp::remove_random_bodies(size_t n/* = -1*/)
 }
 
 
-//----------------------------------------------------------------------------
-size_t OONApp::add_entity(Entity&& temp) //override
-// Add new entity (moved) from a temporary template obj.
-{
-	auto ndx = SimApp::add_entity(temp);
-	// Pre-cache shapes for rendering... (!! May be pointless, but this is just what I started with...)
-	oon_main_view().create_cached_shape(entity(ndx), ndx); // temp is dead now... ()
-	return ndx;
-}
-
 //----------------------------------------------------------------------------
 size_t OONApp::add_random_body_near(size_t base_ndx)
 //!! This is still a version of (mass-ignoring) spawn()!...
 //!! Callers may not know, but this depends on the properties of the player body!
 //!! See also spawn() (that calls this), which is at least is explicit about it!
+{
+	return add_entity(random_body_near(base_ndx));
+}
+
+OONApp::Entity OONApp::random_body_near(size_t base_ndx) const
 {
 	//!! These should be either static, or actually depend on dynamic state...
-	const auto& cw = const_world();
+	const auto& cw = world();
 //	auto constexpr r_min = cw.CFG_GLOBE_RADIUS / 9;
 //	auto constexpr r_max = cw.CFG_GLOBE_RADIUS * 3;
 	auto constexpr p_range = cw.CFG_GLOBE_RADIUS * 30;
@@ -693,40 +764,43 @@ size_t OONApp::add_random_body_near(size_t base_ndx)
 	auto M_max = base.mass * 3;
 
 //cerr << "Adding new object #" << cw.bodies.size() + 1 << "...\n";
-	return add_entity({
+	return {
 		.p = { (rand() * p_range) / RAND_MAX - p_range/2 + base.p.x,
 		       (rand() * p_range) / RAND_MAX - p_range/2 + base.p.y },
 		.v = { (rand() * v_range) / RAND_MAX - v_range/2 + base.v.x * 0.05f,
 		       (rand() * v_range) / RAND_MAX - v_range/2 + base.v.y * 0.05f },
 		.color = 0xffffff & ((uint32_t) rand() * rand()),
 		.mass = M_min + (M_max - M_min) * float(rand())/RAND_MAX,
-	});
+	};
 }
 
 //----------------------------------------------------------------------------
 void OONApp::remove_entity(size_t ndx) //override
 {
+	//! The focus/hover handles just go stale if their entity is removed, and
+	//! stay valid if it's only moved (to `ndx`) by the removal.
+	if (world().bodies.handle(ndx) == focused_entity) {
+cerr << "- WARNING: The followed object has ceased to exist...\n";
+		//!! Don't just fall back to the player!
+		//!! That'd be too subtle/unexpected/unwanted.
+	}
+
 	SimApp::remove_entity(ndx);
+}
 
-	//-------------------------
-	// Adjust references...
-	//--------------
+//----------------------------------------------------------------------------
+size_t OONApp::remove_terminated_entities(std::vector<size_t>* removed) //override
+{
+	bool had_focus = focused_entity_ndx() != ~0u;
+
+	auto count = SimApp::remove_terminated_entities(removed);
+	if (!count) return 0;
 
-	// Focus obj.:
-	if (focused_entity_ndx != ~0u) {
-		if (focused_entity_ndx > ndx) {
-//cerr << "- NOTE: Index of the followed object has changed due to object removal.\n";
-			--focused_entity_ndx;
-		} else if (focused_entity_ndx == ndx) {
+	if (had_focus && focused_entity_ndx() == ~0u) {
 cerr << "- WARNING: The followed object has ceased to exist...\n";
-			focused_entity_ndx = ~0u; //!! Don't just fall back to the player!
-		}                                 //!! That'd be too subtle/unexpected/unwanted.
 	}
 
-	assert(focused_entity_ndx == ~0u || focused_entity_ndx < entity_count());
-
-	// Remove from the view cache, too:
-	oon_main_view().delete_cached_shape(ndx);
+	return count;
 }
 
 
@@ -759,9 +833,10 @@ if (parent_ndx != player_entity_ndx()) cerr << "- INTERANL: Non-player object #"
 
 	backend.audio.play_sound(n == 1 ? snd_plop1 : n <= 10 ? snd_plop2 : snd_plop3 );
 
-	for (size_t i = 0; i < n; ++i) {
-		auto ndx = add_random_body_near(player_entity_ndx());
-		auto& newborn = entity(ndx);
+	auto first = entity_count();
+	add_random_bodies_near(player_entity_ndx(), n);
+	for (auto ndx = first; ndx < first + n; ++ndx) {
+		auto newborn = entity(ndx);
 		newborn.lifetime = Entity::Unlimited;
 		newborn.T = parent.T; // #155: Inherit temperature
 		newborn.v = parent.v; // 1e5e8be3: Inherit speed
@@ -796,9 +871,11 @@ void OONApp::exhaust_burst(size_t base_ndx/* = 0*/, /*Math::Vector2f thrust_vect
 		.particle_mass_min = Phys::mass_from_radius_and_density(r_min, Phys::DENSITY_OF_EARTH), //!! WAS: exhaust_density
 		.particle_mass_max = Phys::mass_from_radius_and_density(r_max, Phys::DENSITY_OF_EARTH), //!! WAS: exhaust_density
 		.color = exhaust_color,
+		.light_particles = appcfg.light_particles,
 	};
 
-	auto& base = entity(base_ndx); // Not const: will deplete!
+	const auto base = const_entity(base_ndx); //! A copy, as the emitters below will add new entities!
+	                                          //! (It gets depleted via its index anyway.)
 
 	// This "accidentally" creates a nice rainbowish color pattern in the plumes...
 	auto adjust_color = [](uint32_t base_color){
@@ -881,6 +958,7 @@ void OONApp::shield_energize(size_t emitter_ndx, /*Math::Vector2f shoot_vector,*
 		.particle_mass_min = Phys::mass_from_radius_and_density(r_min, Phys::DENSITY_OF_EARTH),
 		.particle_mass_max = Phys::mass_from_radius_and_density(r_max, Phys::DENSITY_OF_EARTH),
 		.color = color,
+		.light_particles = appcfg.light_particles,
 	}, *this);
 
 //	emitter_cfg.eject_velocity = entity(emitter_ndx).v;
@@ -902,20 +980,22 @@ void OONApp::chemtrail_burst(size_t emitter_ndx/* = 0*/, unsigned n/* = ...*/)
 	static auto  M_min = Phys::mass_from_radius_and_density(r_min, chemtrail_density);
 	static auto  M_max = Phys::mass_from_radius_and_density(r_max, chemtrail_density);
 
-	auto& emitter = entity(emitter_ndx); // Not const: will deplete!
+	const auto emitter = const_entity(emitter_ndx); //! A copy, as adding the particles would invalidate a ref.!
 	auto p_range = emitter.r * 5;
 	auto v_range = Model::World::CFG_GLOBE_RADIUS * chemtrail_divergence; //!! ...by magic, right? :-/
 
-	auto emitter_old_r = emitter.r;
+	auto emitter_mass = emitter.mass; // Will deplete!
+
+	if (!appcfg.light_particles) world().bodies.reserve_more(n);
 
 	for (unsigned i = 0; i++ < n;) {
 		auto particle_mass = M_min + (M_max - M_min) * float(rand())/RAND_MAX;
-		if (!chemtrail_creates_mass && emitter.mass < particle_mass) {
+		if (!chemtrail_creates_mass && emitter_mass < particle_mass) {
 //cerr << "- Not enough mass to emit particle...\n";
 			continue;
 		}
 
-		add_entity({
+		Entity particle = {
 			.lifetime = chemtrail_lifetime,
 			.density = chemtrail_density,
 			//!!...Jesus, those "hamfixted" pseudo Δts here! :-o :)
@@ -925,15 +1005,23 @@ void OONApp::chemtrail_burst(size_t emitter_ndx/* = 0*/, unsigned n/* = ...*/)
 			       (rand() * v_range) / RAND_MAX - v_range/2 + emitter.v.y * chemtrail_v_factor },
 			.color = (uint32_t) (float)0xffffff * rand(),
 			.mass = particle_mass,
-		});
+		};
+		if (appcfg.light_particles) {
+			world().particles.emit(particle.p.x, particle.p.y, particle.v.x, particle.v.y,
+				Phys::radius_from_mass_and_density(particle_mass, chemtrail_density),
+				chemtrail_lifetime, particle.color);
+		} else {
+			add_entity(std::move(particle));
+		}
 
-		if (!chemtrail_creates_mass) emitter.mass -= particle_mass;
-//cerr <<"emitter.mass -= emitter_mass_loss: "<< emitter.mass <<" -= "<< particle_mass <<'\n';
+		if (!chemtrail_creates_mass) emitter_mass -= particle_mass;
+//cerr <<"emitter_mass -= emitter_mass_loss: "<< emitter_mass <<" -= "<< particle_mass <<'\n';
 	}
 
-	assert(emitter.mass >= 0);
-	emitter.recalc();
-	resize_shape(emitter_ndx, float(emitter.r / emitter_old_r));
+	auto depleted = entity(emitter_ndx);
+	depleted.mass = emitter_mass;
+	assert(depleted.mass >= 0);
+	depleted.recalc(); // (The view follows the new r by itself.)
 }
 
 
@@ -1032,13 +1120,11 @@ void OONApp::updates_for_next_frame()
 
 			++iterations;
 
-			// Clean-up decayed bodies:
-			for (size_t i = player_entity_ndx() + 1; i < entity_count(); ++i) {
-				auto& e = entity(i);
-				if (e.lifetime != Entity::Unlimited && e.lifetime <= 0) {
-					remove_entity(i); // Takes care of "known" references, too!
-				}
-			}
+			// Clean-up decayed bodies (all at once):
+			remove_terminated_entities(); // Takes care of "known" references, too!
+
+			// Restore the spatial locality of the bodies every now and then:
+			if (world().reorder_due()) reorder_entities();
 
 		} else {
 			if (cfg.exit_on_finish) {
@@ -1069,26 +1155,26 @@ void OONApp::updates_for_next_frame()
 	// - ...
 
 	ui_gebi(ObjMonitor).active(
-		hovered_entity_ndx < entity_count() ||
-		focused_entity_ndx < entity_count()
+		hovered_entity_ndx() < entity_count() ||
+		focused_entity_ndx() < entity_count()
 	);
 
 	auto _focus_locked_ = false;
 	if (scroll_locked()) {
 		// Panning follows focused obj. with locked focus point:
 		_focus_locked_ = true;
-		if (focused_entity_ndx != ~0u)
-			pan_to_focus(focused_entity_ndx);
+		if (focused_entity_ndx() != ~0u)
+			pan_to_focus(focused_entity_ndx());
 	} else {
 		// Focus point follows focused obj., with panning only if drifting off-screen:
 		//!! Should be possible to switch this off!
-		if (focused_entity_ndx != ~0u) {
+		if (focused_entity_ndx() != ~0u) {
 static const float autofollow_margin    = appcfg.get("controls/autofollow_margin", 100.f);
 static const float autofollow_throwback = appcfg.get("controls/autofollow_throwback", 2.f);
 static const float autozoom_delta       = appcfg.get("controls/autozoom_rate", 0.1f);
 			oon_main_camera().focus_offset = oon_main_camera().world_to_view_coord(
-				Vector2f(entity(focused_entity_ndx).p));
-			if (oon_main_camera().confine(Vector2f(entity(focused_entity_ndx).p),
+				Vector2f(const_entity(focused_entity_ndx()).p));
+			if (oon_main_camera().confine(Vector2f(const_entity(focused_entity_ndx()).p),
 			    autofollow_margin + autofollow_margin/2 * oon_main_camera().scale()/OONConfig::DEFAULT_ZOOM,
 			    autofollow_throwback)) { // true = drifted off
 				zoom_control(AutoFollow, -autozoom_delta); // Emulate the mouse wheel...
@@ -1105,6 +1191,13 @@ static const float autozoom_delta       = appcfg.get("controls/autozoom_rate", 0
 
 	view_control(); // Manual view adjustments
 
+	//----------------------------
+	// Hand the new state over to the drawing (which may be in another thread)...
+	//!
+	//! NOTE: MUST COME LAST, AFTER THE VIEW ADJUSTMENTS, TOO!
+	//!
+	if (!cfg.headless) oon_main_view().publish_snapshot();
+
 //!!IPROF_SYNC_THREAD;
 }
 
@@ -38,6 +38,9 @@ protected:
 	void init() override;
 	void done() override;
 
+	// Compare the current (final) state with a saved one (see --compare-with):
+	bool compare_with_reference(const std::string& state_file, float tolerance);
+
 //----------------------------------------------------------------------------
 // Operations...
 //----------------------------------------------------------------------------
@@ -121,6 +124,7 @@ public:
 	//!!Make a proper distinction between these and player/user actions!
 	//!!(One thing's that those tend/should go through the UI, whereas these shouldn't.)
 	size_t add_random_body_near(size_t base_ndx);
+	Entity random_body_near(size_t base_ndx) const; // Just the template for add_random_body_near()
 	void   add_random_bodies_near(size_t base_ndx, size_t n);
 	void   remove_random_body();
 	void   remove_random_bodies(size_t n = -1); // -1 -> all
@@ -138,14 +142,11 @@ protected:
 	//------------------------------------------------------------------------
 	// Op. implementations/overrides...
 	void updates_for_next_frame() override;
-	size_t add_entity(Entity&& temp) override;
 	void remove_entity(size_t ndx) override;
+	size_t remove_terminated_entities(std::vector<size_t>* removed = nullptr) override;
 //	void transform_entity(EntityTransform f) override;
 //	void transform_entity(EntityTransform_ByIndex f) override;
 	//--------------------------------------------------------------------
-	void resize_shape(size_t /*ndx*/, float /*factor*/) override;
-	void resize_shapes(float /*factor*/) override;
-
 	void time_step(int steps) override;
 	bool load_snapshot(const char* fname) override; // Needs to reset the rendering cache!
 	//bool save_snapshot(const char* fname) override; // Nothing special to do for this one.
@@ -156,9 +157,9 @@ protected:
 	//!! And then the model callback mechanism could be simplified to not doing it in
 	//!! the core abstract Model at all, but in the custom layer, only when needed.
 	void init_world_hook() override;
-	void undirected_interaction_hook(Model::World* w, Entity* obj1, Entity* obj2, float dt, double distance, ...) override;
-	void directed_interaction_hook(Model::World* w, Entity* source, Entity* target, float dt, double distance, ...) override;
-	bool touch_hook(Model::World* w, Entity* obj1, Entity* obj2) override;
+	void undirected_interaction_hook(Model::World* w, EntityRef obj1, EntityRef obj2, float dt, double distance, ...) override;
+	void directed_interaction_hook(Model::World* w, EntityRef source, EntityRef target, float dt, double distance, ...) override;
+	bool touch_hook(Model::World* w, EntityRef obj1, EntityRef obj2) override;
 
 	//------------------------------------------------------------------------
 	// Other callback impl. (overrides)...
@@ -197,6 +198,7 @@ protected:
 	//!!using HUD_ID = _UI_::HUD_ID; using enum _UI_::HUD_ID; // Also import all the values!
 	virtual UI::HUD& ui_gebi(HUD_ID which) = 0; // get_element_by_id(...)
 	using GravityModeSelector = sfw::OptionsBox<Model::World::GravityMode>;
+	using IntegratorSelector = sfw::OptionsBox<Model::World::Integrator>;
 
 
 	// Chores after loading a new model world:
@@ -237,8 +239,13 @@ protected:
 	size_t snd_shield;
 
 public://!! Directly accessed by e.g. main_view() and the ObjMonitor HUD:
-	size_t focused_entity_ndx = 0; // The player object by default
-	size_t hovered_entity_ndx = ~0u; // None
+	// Handles, not indexes, as those may change as other entities are removed:
+	Model::World::Handle focused_entity; // The player object by default (see init())
+	Model::World::Handle hovered_entity; // None
+	size_t focused_entity_ndx() const { return world().bodies.index_of(focused_entity); } // ~0u if none (or gone)
+	size_t hovered_entity_ndx() const { return world().bodies.index_of(hovered_entity); } // - " -
+	void   focus_entity(size_t ndx) { focused_entity = ndx < entity_count() ? world().bodies.handle(ndx) : Model::World::Handle{}; }
+	void   hover_entity(size_t ndx) { hovered_entity = ndx < entity_count() ? world().bodies.handle(ndx) : Model::World::Handle{}; }
 };
 
 } // namespace OON
@@ -50,6 +50,8 @@ OONConfig::OONConfig(Szim::SimAppConfig& syscfg, [[maybe_unused]] const Args& ar
 	hud_font_file       = get("appearance/HUD/font_file", default_font_file);
 	hud_line_height     = get("appearance/HUD/line_height", UI::HUD::DEFAULT_LINE_HEIGHT);
 	hud_line_spacing    = get("appearance/HUD/line_spacing", UI::HUD::DEFAULT_LINE_SPACING);
+	batched_rendering   = get("appearance/batched_rendering", false);
+	render_thread       = get("appearance/render_thread", false);
 
 	player_thrust_force       = get("sim/player_thrust_force", 1e35f); // N (kg*m/s^2)
 
@@ -66,6 +68,8 @@ OONConfig::OONConfig(Szim::SimAppConfig& syscfg, [[maybe_unused]] const Args& ar
 //!!	shield_feed_rate          = get("sim/shield_replenish_rate", 5.f);
 	shield_burst_particles    = get("sim/shield_replenish_rate", 5);
 
+	light_particles           = get("sim/light_particles", false);
+
 
 	// 3. Process cmdline args to override again...
 //!! See also main.cpp! And if main goes to Szim [turning all this essentially into a framework, not a lib, BTW...],
@@ -55,6 +55,8 @@ struct OONConfig : Szim::Config
 	std::string hud_font_file;
 	unsigned    hud_line_height;
 	unsigned    hud_line_spacing;
+	bool        batched_rendering; // All the bodies (but the player) as one vertex array, in a single draw call
+	bool        render_thread;     // Draw (and wait for the frame limit) in a separate thread, not between the updates
 
 	std::string background_music; //!!?? Awkward... App stuff that needs convenient engine support. How exactly?
 
@@ -68,6 +70,7 @@ struct OONConfig : Szim::Config
 	float    shield_depletion_time; // s
 	float    shield_recharge_time;  // s
 	unsigned shield_burst_particles; // new particles/frame (normalized to 30FPS)
+	bool     light_particles; // Emit into the world's particle pool, not as bodies
 
 	//----------------------------------------------------------------------------
 	OONConfig(Szim::SimAppConfig& syscfg, const Args& args);
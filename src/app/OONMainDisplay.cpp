@@ -1,5 +1,6 @@
 #include "OONMainDisplay.hpp"
 #include "OONConfig.hpp"
+#include "OON.hpp"
 
 #include <iostream> //!! DEBUG
 	using std::cerr;
@@ -24,6 +25,50 @@ OONMainDisplay::OONMainDisplay(OONViewConfig cfg, OONApp& app)
 cerr <<	"DBG> OONMainDisplay ctor: camera pointer is now: " << _camera << "\n";
 }
 
+//----------------------------------------------------------------------------
+void OONMainDisplay::publish_snapshot()
+// Copy the drawable state of the world (+ the camera etc.) into the back slot
+// of `snapshots` (its vectors are reused across ticks), and swap it in.
+{
+	auto& game = _app;
+	const auto& bodies = game.const_world().bodies;
+	const auto& particles = game.const_world().particles;
+	auto& snap = snapshots.back();
+
+	const auto n = bodies.size();
+	snap.px.resize(n); snap.py.resize(n); snap.r.resize(n); snap.color.resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		snap.px[i] = float(bodies.px[i]);
+		snap.py[i] = float(bodies.py[i]);
+		snap.r[i]  = float(bodies.r[i]);
+		snap.color[i] = bodies.cold[i].color;
+	}
+
+	snap.ppx.clear(); snap.ppy.clear(); snap.pr.clear(); snap.pcolor.clear();
+	for (size_t i = 0; i < particles.size(); ++i) {
+		if (!particles.alive(i)) continue;
+		auto alpha = p_alpha;
+		if (particles.lifetime[i] != Model::Unlimited)
+			alpha = uint8_t(float(p_alpha) * (1.f - particles.age[i] / particles.lifetime[i]));
+		snap.ppx.push_back(float(particles.px[i]));
+		snap.ppy.push_back(float(particles.py[i]));
+		snap.pr.push_back(float(particles.r[i]));
+		snap.pcolor.push_back((particles.color[i] << 8) | alpha);
+	}
+
+	snap.player_ndx = game.player_entity_ndx();
+	snap.avatar_ndx = game.focused_entity_ndx();
+	snap.player_idle_time = game.player_idle_time();
+	snap.session_time = game.session_time();
+	snap.paused = game.paused();
+	snap.alpha = p_alpha;
+	snap.width = game.main_window_width();
+	snap.height = game.main_window_height();
+	snap.camera = oon_camera();
+
+	snapshots.publish();
+}
+
 /*
 void OONMainDisplay::reset(const Config* recfg)
 {
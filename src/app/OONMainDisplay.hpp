@@ -3,12 +3,14 @@
 
 #include "Engine/View/ScreenView.hpp"
 #include "Engine/View/OrthoZoomCamera.hpp"
+#include "Engine/TripleBuffer.hpp"
 
 //!!namespace Model { class World; class World::Body; } //!! *Sigh*, C++, still nope! :-o https://stackoverflow.com/a/36736618/1479945
 #include "Model/World.hpp"
 //#include "Model/Math/Vector2.hpp"
 
 #include <cstdint>
+#include <vector>
 
 
 namespace OON {
@@ -56,15 +58,50 @@ public:
 	void undim() { p_alpha = ALPHA_ACTIVE; }
 
 	// -------------------------------------------------------------------
-	// Pure virtuals for the actual drawing impl...
-	virtual void create_cached_shape(const Model::World::Body& body, size_t entity_ndx) = 0;
-	virtual void delete_cached_shape(size_t entity_ndx) = 0;
-	virtual void resize_objects(float factor) = 0;
-	virtual void resize_object(size_t ndx, float factor) = 0;
+	// The state of the scene to draw, published at the end of each model update
+	// (see publish_snapshot()), so drawing (possibly in another thread; see
+	// OONConfig::render_thread) never has to touch the live world:
+	struct RenderSnapshot
+	{
+		// Per body (at the entity indexes):
+		std::vector<float> px, py, r;
+		std::vector<uint32_t> color; // 0xRRGGBB
+		// Per live particle:
+		std::vector<float> ppx, ppy, pr;
+		std::vector<uint32_t> pcolor; // 0xRRGGBBAA (faded with age)
+
+		size_t   player_ndx = ~0u;  // ~0u: none (yet)
+		size_t   avatar_ndx = 0;    // (The focused entity, see OONMainDisplay_sfml::avatar()...)
+		float    player_idle_time = 0;
+		float    session_time = 0;
+		bool     paused = false;
+		uint8_t  alpha = ALPHA_ACTIVE;
+		unsigned width = 0, height = 0; // Of the main window
+		MainCameraType camera{{}};
+
+		size_t size() const { return px.size(); }
+	};
+	Szim::TripleBuffer<RenderSnapshot> snapshots;
+
+	void publish_snapshot(); // Updates thread only! (The producer side of `snapshots`.)
+
+	// Bodies smaller than this (radius, in pixels) are drawn as single points:
+	constexpr static float LOD_RADIUS = 0.5f;
+
+	// Per-frame counters of the last rendered frame:
+	struct RenderStats {
+		size_t drawn = 0;  // Fully (as shapes, or quads)
+		size_t lod = 0;    // As points (see LOD_RADIUS)
+		size_t culled = 0; // Out of view
+	} render_stats;
 
 	//!! Sigh... Move this to the UI already:
 	virtual void draw_banner(const char* text) = 0;
 
+	// Load the images of the app's avatars (all of them, before any drawing;
+	// they are read-only from then on, so the drawing can go on in any thread):
+	virtual void load_avatars() = 0;
+
 	// -------------------------------------------------------------------
 	// Data...
 	// -------------------------------------------------------------------
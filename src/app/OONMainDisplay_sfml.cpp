@@ -13,10 +13,14 @@
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/CircleShape.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
 
 #include <memory>
 	using std::make_shared;
-#include <cmath> // sin //!! Seriously, replace with a fast table lookup!
+#include <cmath> // sin, hypot //!! Seriously, replace with a fast table lookup!
+#include <algorithm> // max, clamp
 #include <cassert>
 #include <iostream> //!! DEBUG
 	using std::cerr;
@@ -48,6 +52,10 @@ OONMainDisplay_sfml::OONMainDisplay_sfml(OONApp& app)
 //!! i.e. no Engine (SimApp) init has been done at all yet! :-o :-/
 //!!	reset(); // Calc. initial state
 
+	// Unit circles, centered (see render_scene()):
+	_circle.setOrigin({1.f, 1.f});
+	_player_shape.setOrigin({1.f, 1.f});
+
 cerr <<	"DBG> OONMainDisplay_sfml ctor: camera pointer is now: " << _camera << "\n";
 }
 
@@ -60,119 +68,64 @@ cerr << "----------------------------------------- "<<__FUNCTION__<<"\n";
 
 	resize(_cfg.width, _cfg.height);
 
+	//! Neither the render records, nor the avatars are touched here: they
+	//! belong to the drawing, which may be going on in another thread (see
+	//! render_scene())! (The avatars are loaded in advance; see load_avatars().)
+}
+
+//----------------------------------------------------------------------------
+void OONMainDisplay_sfml::load_avatars() // override
+{
 	const auto& c_simapp = app();
 
 	// Load avatars -- !!TESTING ONLY!!
+	// (Only the new ones, in case it's called again.)
 	Avatar_sfml::prefix_path = c_simapp.cfg.asset_dir.c_str(); // Can be set per instance, too.
-	for (const auto& a : c_simapp.avatars) {
+	for (auto i = _avatars.size(); i < c_simapp.avatars.size(); ++i) {
+		const auto& a = c_simapp.avatars[i];
 		_avatars.emplace_back(std::make_unique<Avatar_sfml>(a));
 // OR:
 //		_avatars.emplace_back(std::make_unique<Avatar_sfml>(
 //			a, Avatar_sfml::PRELOAD, c_simapp.cfg.asset_dir.c_str()
 //		));
 	}
-
-	// Recreate the shapes...
-	shapes_to_change.clear();
-	shapes_to_draw.clear();
-
-	for (size_t n = 0; n < c_simapp.world().bodies.size(); ++n) {
-		create_cached_shape(*(c_simapp.world().bodies[n]), n); // * for smart_ptr
-	}
-}
-
-
-//----------------------------------------------------------------------------
-void OONMainDisplay_sfml::create_cached_shape(const Model::World::Body& body, size_t entity_ndx) //override
-{
-	auto& game = app();
-
-	// There must be objects actually added already:
-	assert(game.const_world().bodies.size() > 0);
-
-	//!!Can only "append" for now, so ndx must refer to the last element...
-	if (entity_ndx == (size_t)-1) entity_ndx = game.const_world().bodies.size() - 1;
-//	assert(entity_ndx == game.world().bodies.size() - 1);
-
-	//! Not all Drawables are also Transformables! (See e.g. vertex arrays etc.)
-	// (But our little ugly circles are, for now; see the assert below!)
-	auto shape = make_shared<sf::CircleShape>(float(body.r) * oon_camera().scale()); //!! float hardcoded!
-	shape->setOrigin({shape->getRadius(), shape->getRadius()});
-	shapes_to_draw.push_back(shape);
-	shapes_to_change.push_back(shape); // "... to transform"
-
-	assert(shapes_to_draw.size()   == entity_ndx + 1);
-	assert(shapes_to_change.size() == entity_ndx + 1);
-
-//!!!!!!!!!!!!!!!!!!!!!!!
-//!!!!!!!!!!!!!!!!!!!!!!! NOT HERE, NOT THIS WAY!
-//!!!!!!!!!!!!!!!!!!!!!!!
-	auto& player_shape = (sf::Shape&) *(shapes_to_draw[0]);
-	player_shape.setTexture(&( avatar(oon_app().focused_entity_ndx).image ), true);
-}
-
-//----------------------------------------------------------------------------
-void OONMainDisplay_sfml::delete_cached_shape(size_t entity_ndx) //override
-{
-	assert(entity_ndx != (size_t)-1);
-	// Requires that the body has already been deleted from the world:
-	[[maybe_unused]] auto& game = app();
-	assert(game.entity_count() == shapes_to_draw.size() - 1);
-	assert(game.entity_count() == shapes_to_change.size() -1);
-	// Some runtime check, too:
-	if (entity_ndx < shapes_to_draw.size() && entity_ndx < shapes_to_change.size()) {
-		shapes_to_draw.erase(shapes_to_draw.begin() + entity_ndx);
-		shapes_to_change.erase(shapes_to_change.begin() + entity_ndx);
-	}
-}
-
-//----------------------------------------------------------------------------
-void OONMainDisplay_sfml::resize_objects(float factor) //override
-//!! Could this just call resize_object(), or that would degrade perf.?
-{
-	transform_objects([factor](sf::Transformable& shape) {
-		shape.setScale(shape.getScale() * factor);
-	});
-}
-
-//----------------------------------------------------------------------------
-void OONMainDisplay_sfml::resize_object(size_t ndx, float factor) //override
-{
-	assert(ndx < shapes_to_change.size());
-	sf::Transformable& shape = *(shapes_to_change[ndx]);
-	shape.setScale(shape.getScale() * factor);
 }
 
 
-
 //----------------------------------------------------------------------------
 //!! Just directly moved from the legacy renderer for now:
-void OONMainDisplay_sfml::render_scene()
+void OONMainDisplay_sfml::render_scene(const RenderSnapshot& snap)
 // Should be idempotent -- doesn't matter normally, but testing could reveal bugs if it isn't!
+//
+// Fills the render records (screen pos., radius, color, flags) of the bodies
+// of the render snapshot, for draw(). Bodies out of the view are culled, and
+// the ones smaller than a pixel (LOD_RADIUS) are just put into a list of points
+// (drawn in one go). In batched mode, the rest go into one vertex list, too
+// (see _add_body_quad()).
+// The player is always drawn (with its avatar; see _player_shape).
+// The counts are in render_stats (for the HUD).
 {
-	// Shape indexes must be the same as the corresponding entity indexes!
-	for (size_t i = 0; i < shapes_to_change.size(); ++i) {
-		auto& body = app().world().bodies[i];
-
-		//!!Sigh, this will break as soon as not just circles would be there...
-		auto shape = dynamic_pointer_cast<sf::Shape>(shapes_to_change[i]);
-
-		// Set color (!!AND CURRENTLY: ALSO TEXTURE!!) to the avatar bg. for those that have an avatar!
-		if (i != app().player_entity_ndx()) { //!! Currently only, also: "the", player has avatar...
-			shape->setFillColor(sf::Color((body->color << 8) | p_alpha));
-		} else {
-			shape->setFillColor(sf::Color(avatar(oon_app().focused_entity_ndx).tint_RGBA));
-			shape->setTexture(&(          avatar(oon_app().focused_entity_ndx).image));
-		}
+	const bool batched = oon_app().appcfg.batched_rendering;
+	const auto& cam = snap.camera;
+	const auto scale = cam.scale();
+	const float cx = float(snap.width/2), cy = float(snap.height/2);
+	const auto player_ndx = snap.player_ndx;
+
+	_records.resize(snap.size()); // Nothing in them is kept from the last frame
 
-		auto& trshape = dynamic_cast<sf::Transformable&>(*shape);
+	render_stats = {};
+	_body_vertices.clear();
+	_lod_vertices.clear();
+
+	// Record indexes must be the same as the corresponding entity indexes!
+	for (size_t i = 0; i < _records.size(); ++i) {
+		auto& rec = _records[i];
 
 		//!! The size and coords. of the screen view pane (UI viewport) are NOT directly
 		//!! related to the camera view, but would obviously be best if they were identical!...
 
 	// a)
-		auto vpos = app().main_view().camera()
-			.world_to_view_coord(Math::Vector2f(body->p));
+		auto vpos = cam.world_to_view_coord(Math::Vector2f(snap.px[i], snap.py[i]));
 				//!! - Math::Vector2f(body->r, -body->r)); //!! Rely on the objects' own origin offset!
 			        //!! Mind the inverted camera & model y, too!
 	// b)
@@ -182,25 +135,112 @@ void OONMainDisplay_sfml::render_scene()
 		//!! Which they currently are NOT... The vertical axis (y) of the camera view is
 		//!! a) inverted wrt. SFML (draw) coords., b) its origin is the center of the camera view.
 		//!! -> #221, #445
-		trshape.setPosition({ vpos.x + float(app().main_window_width()/2),
-			             -vpos.y + float(app().main_window_height()/2)}); //!! "Standardize" on the view's centered origin instead!
+		rec.pos = { vpos.x + cx, -vpos.y + cy }; //!! "Standardize" on the view's centered origin instead!
+		rec.r = snap.r[i] * scale;
+		rec.flags = 0;
+
+		if (i == player_ndx) { //!! Currently only, also: "the", player has avatar...
+			// Set color (!!AND CURRENTLY: ALSO TEXTURE!!) to the avatar bg. for those that have an avatar!
+			const auto& av = avatar(snap.avatar_ndx);
+			rec.color = sf::Color(av.tint_RGBA);
+			rec.flags = RenderRecord::Visible | RenderRecord::Player;
+			_player_shape.setFillColor(rec.color);
+			if (_player_shape.getTexture() != &av.image)
+				_player_shape.setTexture(&av.image, true); // (Re)fit the texture rect, too
+			_player_shape.setPosition(rec.pos);
+			_player_shape.setScale({rec.r, rec.r}); // Unit circle
+			++render_stats.drawn;
+			continue;
+		}
+
+		if (!cam.visible_in_view(vpos, rec.r)) { ++render_stats.culled; continue; }
+
+		rec.color = sf::Color((snap.color[i] << 8) | snap.alpha);
+		if (rec.r < LOD_RADIUS) {
+			rec.flags = RenderRecord::Visible | RenderRecord::Point;
+			_lod_vertices.push_back({rec.pos, rec.color});
+			++render_stats.lod;
+			continue;
+		}
+		rec.flags = RenderRecord::Visible;
+		++render_stats.drawn;
+		if (batched) _add_body_quad(rec.pos, rec.r, rec.color);
 
 //cerr << "render(): shape.setPos -> x = " << oon_camera.cfg.width /2 + (body->p.x) * oon_camera.scale() + oon_camera.offset.x
 //			       << ", y = " << oon_camera.cfg.height/2 + (body->p.y) * oon_camera.scale() + oon_camera.offset.y <<'\n';
 	}
+
+	_render_particles(snap);
+}
+
+//----------------------------------------------------------------------------
+void OONMainDisplay_sfml::_add_body_quad(sf::Vector2f pos, float r, sf::Color color)
+// Like the particles, but with a (smooth-edged) disc texture on the quads, instead
+// of an sf::CircleShape (i.e. a triangle fan + a draw call) for each body.
+{
+	constexpr unsigned DISC_SIZE = 64; // Texture size (px)
+
+	if (!_disc_texture) { // Once
+		sf::Image disc({DISC_SIZE, DISC_SIZE}, sf::Color::Transparent);
+		constexpr float R = DISC_SIZE / 2.f;
+		for (unsigned y = 0; y < DISC_SIZE; ++y)
+			for (unsigned x = 0; x < DISC_SIZE; ++x) {
+				// Alpha: ~the coverage of the pixel, for antialiased edges
+				auto d = std::hypot(float(x) + 0.5f - R, float(y) + 0.5f - R);
+				disc.setPixel({x, y}, sf::Color(255, 255, 255, uint8_t(std::clamp(R - d, 0.f, 1.f) * 255)));
+			}
+		_disc_texture = make_shared<sf::Texture>();
+		if (!_disc_texture->loadFromImage(disc)) {
+			cerr << "- ERROR: Failed to create the texture for the batched rendering!\n";
+		}
+		_disc_texture->setSmooth(true);
+	}
+
+	constexpr float T = float(DISC_SIZE);
+	const float x = pos.x, y = pos.y;
+	sf::Vertex a{{x - r, y - r}, color, {0, 0}}, b{{x + r, y - r}, color, {T, 0}},
+	           c{{x + r, y + r}, color, {T, T}}, d{{x - r, y + r}, color, {0, T}};
+	for (auto& v : {a, b, c, a, c, d}) _body_vertices.push_back(v);
+}
+
+//----------------------------------------------------------------------------
+void OONMainDisplay_sfml::_render_particles(const RenderSnapshot& snap)
+// No shapes for these, just a square (already faded with age, see
+// publish_snapshot()) for each, into one vertex list, for a single draw call.
+{
+	const auto& cam = snap.camera;
+	const auto scale = cam.scale();
+	const float cx = float(snap.width/2), cy = float(snap.height/2);
+
+	_particle_vertices.clear();
+	for (size_t i = 0; i < snap.ppx.size(); ++i) {
+		auto vpos = cam.world_to_view_coord(Math::Vector2f(snap.ppx[i], snap.ppy[i]));
+		float x = vpos.x + cx, y = -vpos.y + cy; // Mind the inverted y (see render_scene())!
+		float h = std::max(snap.pr[i] * scale, 0.5f); // At least 1 pixel
+		sf::Color color(snap.pcolor[i]);
+
+		sf::Vertex a{{x - h, y - h}, color}, b{{x + h, y - h}, color},
+		           c{{x + h, y + h}, color}, d{{x - h, y + h}, color};
+		for (auto& v : {a, b, c, a, c, d}) _particle_vertices.push_back(v);
+	}
 }
 
 
 void OONMainDisplay_sfml::draw() // override
+// Draws the latest published render snapshot (or the same one again, if there's
+// no newer one yet), without touching the live world (see publish_snapshot()).
 {
-	render_scene(); //!!?? Is this worth keeping separated from draw()?
-	                //!!?? Probably, for occlusion etc. not relevant for any non-model frippery!
+	snapshots.acquire();
+	const auto& snap = snapshots.front();
+
+	render_scene(snap); //!!?? Is this worth keeping separated from draw()?
+	                    //!!?? Probably, for occlusion etc. not relevant for any non-model frippery!
 
 	// Grid lines...
 	static sf::Color hair_color{0x44444488};
-	if (const auto& cam = oon_camera(); cam.cfg.gridlines) {
-		float min_x = 0, max_x = float(app().main_window_width());
-		float min_y = 0, max_y = float(app().main_window_height());
+	if (const auto& cam = snap.camera; cam.cfg.gridlines) {
+		float min_x = 0, max_x = float(snap.width);
+		float min_y = 0, max_y = float(snap.height);
 		auto [vx, vy] = cam.grid_offset();//!!?? + Math::Vector2f{max_x/2, max_y/2};
 		vx += max_x/2;
 		vy = max_y/2 - vy;
@@ -220,32 +260,48 @@ SFML_WINDOW(game).draw(hcenterline, 2, sf::PrimitiveType::Lines);
 	}
 
 	//!!?? render(some target or context or options?) and is it worth separating from draw()?
-	// Draw the world/scene...
-	for (const auto& entity : shapes_to_draw) {
-		SFML_WINDOW(app()).draw(*entity);
+	// Draw the world/scene (only the visible part; see render_scene())...
+	if (!_lod_vertices.empty()) {
+		SFML_WINDOW(app()).draw(_lod_vertices.data(), _lod_vertices.size(), sf::PrimitiveType::Points);
+	}
+	if (!_body_vertices.empty()) { // Batched mode
+		SFML_WINDOW(app()).draw(_body_vertices.data(), _body_vertices.size(), sf::PrimitiveType::Triangles,
+		                        sf::RenderStates(_disc_texture.get()));
+	}
+	if (!oon_app().appcfg.batched_rendering) {
+		for (const auto& rec : _records) {
+			if (rec.flags != RenderRecord::Visible) continue; // Culled, a point, or the player
+			_circle.setPosition(rec.pos);
+			_circle.setScale({rec.r, rec.r});
+			_circle.setFillColor(rec.color);
+			SFML_WINDOW(app()).draw(_circle);
+		}
+	}
+	const auto player_ndx = snap.player_ndx;
+	if (player_ndx < snap.size()) SFML_WINDOW(app()).draw(_player_shape); // (None before the first snapshot)
+	if (!_particle_vertices.empty()) {
+		SFML_WINDOW(app()).draw(_particle_vertices.data(), _particle_vertices.size(), sf::PrimitiveType::Triangles);
 	}
-
 
 	// Player halo...
 	// Only if the real size is too small...
-	const auto player_ndx = app().player_entity_ndx();
-	const auto& player_body = app().player_entity();
 
 	//!! May not remain a circle forever:
-	auto& player_shape = (sf::CircleShape&) *(shapes_to_change[player_ndx]);
+	auto& player_shape = _player_shape;
 
-	auto rb = player_body.r * oon_camera().scale();
+	const bool has_player = player_ndx < snap.size();
+	auto rb = has_player ? snap.r[player_ndx] * snap.camera.scale() : 0.f;
 //	auto rb = ((sf::CircleShape&)player_shape).getRadius();
 	static float A = 1.f; // pixel
 	static float f = 2.0f; // Hz
-	float phase = app().session_time() * f * 2*3.141f;
+	float phase = snap.session_time * f * 2*3.141f;
 	float y = sin(phase);
-	if (rb < 16) {
+	if (has_player && rb < 16) {
 		float r = 20 + y * A/2;
 		//r -= sin(phase) * 2/2; // Compensate when only pulsating the outline thickness.
 		auto halo = sf::CircleShape(r);
 		halo.setOutlineThickness(2); //(y * 2);
-		halo.setOutlineColor(sf::Color(unsigned((app().entity(player_ndx).color << 8)
+		halo.setOutlineColor(sf::Color(unsigned((snap.color[player_ndx] << 8)
 		                                        | 0x60 + unsigned(y * 20))));
 		halo.setFillColor(sf::Color(0)); // sf::Color(0x66663333)
 		halo.setOrigin({r, r});
@@ -257,17 +313,17 @@ SFML_WINDOW(game).draw(hcenterline, 2, sf::PrimitiveType::Lines);
 	// Idle-rotate the player avatar...
 	static float idle_rot_threshold = 2;
 	static float idle_rot_rate_inv = 5;
-	if (app().player_idle_time() > idle_rot_threshold)
+	if (snap.player_idle_time > idle_rot_threshold)
 	{
 		player_shape.setRotation(
-			sf::radians((app().player_idle_time() - idle_rot_threshold) / idle_rot_rate_inv)
+			sf::radians((snap.player_idle_time - idle_rot_threshold) / idle_rot_rate_inv)
 		);
 	} else {
 		player_shape.setRotation(sf::radians(0));
 	}
 
 	//!!MOVE THIS TO THE UI:
-	if (app().paused()) {
+	if (snap.paused) {
 		draw_banner("PAUSED");
 	}
 }
@@ -5,10 +5,10 @@
 
 #include "OONAvatar_sfml.hpp" // for focused_entity_ndx (and, not yet, but...: app.appcfg)
 
-// For the cached SFML shapes:
-//#include <SFML/Graphics/Transformable.hpp>
-//#include <SFML/Graphics/Drawable.hpp>
-namespace sf { class Transformable; class Drawable; }
+namespace sf { class Texture; }
+#include <SFML/Graphics/CircleShape.hpp> // For drawing the render records
+#include <SFML/Graphics/Vertex.hpp> // For the particles
+#include <cstdint>
 #include <vector>
 #include <memory> // shared_ptr, unique_ptr
 
@@ -38,6 +38,7 @@ public:
 	OONMainDisplay_sfml(class OONApp& app); //! Nice, this isn't even required to be OONApp_sfml.
 
 	void reset(const Config* recfg = nullptr) override; // Resets things to the last cfg if null.
+	void load_avatars() override;
 //	void reset(Config&& recfg) override;
 //	void resize(unsigned width, unsigned height) override;
 
@@ -53,12 +54,6 @@ public:
 	// App-specific features...
 	// -------------------------------------------------------------------
 
-	// SFML-specific overrides
-	void create_cached_shape(const Model::World::Body& body, size_t entity_ndx) override;
-	void delete_cached_shape(size_t entity_ndx) override;
-	void resize_objects(float factor) override;
-	void resize_object(size_t ndx, float factor) override;
-
 	//!! Move it to the UI, FFS:
 	void draw_banner(const char* text) override;
 
@@ -67,21 +62,9 @@ public:
 	// Internals...
 	// -------------------------------------------------------------------
 protected:
-	void render_scene(); //!!?? render_scene(some target or context or options?)
-
-	// Note: these are templates (by the auto arg), so must be in the header!
-	void transform_object(size_t ndx, const auto& op) {
-		auto& trshape = dynamic_cast<sf::Transformable&>(shapes_to_change[ndx]);
-		op(trshape);
-	}
-	void transform_objects(const auto& op) // c++20 auto lambda ref (but why the `const` required by MSVC?); https://stackoverflow.com/a/67718838/1479945
-	// op = [](Transformable& shape);
-	{
-		for (auto& shape : shapes_to_change) {
-			auto& trshape = dynamic_cast<sf::Transformable&>(*shape);
-			op(trshape);
-		}
-	}
+	void render_scene(const RenderSnapshot& snap); //!!?? render_scene(some target or context or options?)
+	void _render_particles(const RenderSnapshot& snap); // snap.p* -> _particle_vertices
+	void _add_body_quad(sf::Vector2f pos, float r, sf::Color color); // -> _body_vertices (batched mode)
 
 	const Avatar_sfml& avatar(size_t ndx = 0) const;
 
@@ -89,17 +72,29 @@ protected:
 	// Data...
 	// -------------------------------------------------------------------
 private:
-	// Two lists ("views") for the same set of shapes, typed differently for
-	// convenience, in order to:
-	// - iterate for updates, and
-	// - iterate for drawing.
-	// (The common ancestor sf::Shape would be way too restritive alone, and
-	// the two lists may also diverge in the future.)
-	std::vector< std::shared_ptr<sf::Drawable> >      shapes_to_draw;
-	std::vector< std::shared_ptr<sf::Transformable> > shapes_to_change;
+	// The render cache: one plain record per entity (at the same index), filled
+	// by render_scene() from the render snapshot, for draw() -- no per-body
+	// objects (or RTTI, refcounts, virtual calls) in the render loop:
+	struct RenderRecord
+	{
+		sf::Vector2f pos; // On screen
+		float r = 0;      // On screen
+		sf::Color color;
+		uint8_t flags = 0;
+		enum : uint8_t { Visible = 1, Point = 2, Player = 4 }; // Not Visible: culled
+	};
+	std::vector<RenderRecord> _records;
+
+	sf::CircleShape _circle{1.f, 30};       // Unit circle, moved (and scaled) around to draw each record
+	sf::CircleShape _player_shape{1.f, 30}; // Same, but with the avatar texture (see render_scene())
 
 	std::vector< std::unique_ptr<Avatar_sfml> > _avatars;
 
+	std::vector<sf::Vertex> _particle_vertices; // 2 triangles each, drawn in one go (reused across frames)
+	std::vector<sf::Vertex> _body_vertices;     // Same for the bodies, in batched mode (see OONConfig::batched_rendering)
+	std::shared_ptr<sf::Texture> _disc_texture; // The circle for those (shared_ptr: sf::Texture is incomplete here)
+	std::vector<sf::Vertex> _lod_vertices;      // One point for each body smaller than a pixel
+
 }; // class OONMainDisplay_sfml
 
 } // namespace OON
@@ -57,10 +57,15 @@ void OONApp::_on_snapshot_loaded()
 	//
 	using namespace sfw;
 
+	// The entity handles of the old world are all stale now:
+	focus_entity(player_entity_ndx());
+	hover_entity(~0u);
+
 	if (!cfg.headless) {
 		// Grav. mode:
 		//!! The grav. bias widget can only do +/-1000x, so no clean mapping from gravity_strength to that! :-/
 		gui.set<GravityModeSelector>("Gravity mode", world().gravity_mode);
+		gui.set<IntegratorSelector>("Integrator", world().integrator);
 
 		// Drag:
 		gui.set<Slider>("Friction", world().friction);
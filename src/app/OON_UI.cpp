@@ -79,6 +79,16 @@ void OONApp::ui_setup()
 			->setCallback([&](auto* w){ app.fps_throttling((unsigned)w->get()); });
 		perf_form->add("Fixed model Δt", new CheckBox(
 			[&](auto*){ app.toggle_fixed_model_dt(); }, app.cfg.fixed_model_dt_enabled));
+#ifndef DISABLE_THREADS
+		perf_form->add("Model threads", new Slider({.length=60, .range={0, 16}, .step=1}))
+			->set(app.world().threads)
+			->setCallback([&](auto* w){ app.world().threads = (unsigned)w->get(); });
+		    gui.recall("Model threads")->setTooltip("0: one per CPU core");
+#endif
+		perf_form->add("Block steps", new Slider({.length=60, .range={0, 12}, .step=1}))
+			->set(app.world().max_step_level)
+			->setCallback([&](auto* w){ app.world().max_step_level = (unsigned)w->get(); });
+		    gui.recall("Block steps")->setTooltip("Max. 2^N gravity sub-steps per tick for close encounters (0: off)");
 
 	gui_main_hbox->add(new Label(" ")); // just a vert. spacer
 
@@ -120,10 +130,27 @@ void OONApp::ui_setup()
 			->setCallback([&](auto* w){ app.world().gravity = Phys::G //!! <- NO! Either use the original base val, or just modify the current .gravity!
 				* Math::power(10.f, w->get()); })
 			->set(0);
+		auto i_select = new IntegratorSelector();
+			i_select->add("Euler",    World::Integrator::Euler);
+			i_select->add("Leapfrog", World::Integrator::Leapfrog);
+			i_select->add("Verlet",   World::Integrator::VelocityVerlet);
+			i_select->set(World::Integrator::Default);
+			i_select->setCallback([&](auto* w){ app.world().integrator = w->get(); });
+		phys_form->add("Integrator", i_select)
+			->set(app.world().integrator);
 #ifndef DISABLE_FULL_INTERACTION_LOOP
 		phys_form->add("Full int. loop", new sfw::CheckBox([&](auto* w){ app.world().loop_mode = w->get() ? World::LoopMode::Full : World::LoopMode::Half; },
 				app.world().loop_mode == World::LoopMode::Full));
 #endif
+		phys_form->add("SIMD kernel", new sfw::CheckBox([&](auto* w){ app.world().simd = w->get(); },
+				app.world().simd));
+		phys_form->add("Grid collisions", new sfw::CheckBox([&](auto* w){ app.world().broadphase = w->get(); },
+				app.world().broadphase));
+		phys_form->add("Barnes-Hut", new sfw::CheckBox([&](auto* w){ app.world().gravity_solver = w->get() ? World::GravitySolver::BarnesHut : World::GravitySolver::Exact; },
+				app.world().gravity_solver == World::GravitySolver::BarnesHut));
+		phys_form->add(" - theta", new sfw::Slider({.length=80, .range={0.1, 1.5}, .step=0}))
+			->setCallback([&](auto* w){ app.world().bh_theta = w->get(); })
+			->set(app.world().bh_theta);
 		phys_form->add("Friction", new sfw::Slider({.length=80, .range={-1.0, 1.0}, .step=0}))
 			->setCallback([&](auto* w){ app.world().friction = w->get(); })
 			->set(app.world().friction);
@@ -216,6 +243,12 @@ void OONApp::ui_setup_HUDs()
 		<< "\nGravity mode: " << [this](){ return to_string((unsigned)const_world().gravity_mode); }
 		<< "\n  - strength: " << &const_world().gravity
 		<< "\nDrag: " << ftos(&this->const_world().friction)
+		<< "\nBody store: " << [this](){ return to_string(const_world().bodies.capacity()) + " cap., "
+			+ to_string(const_world().bodies.stats().regrowths) + " reallocs"; }
+		<< "\nParticles: " << [this](){ return to_string(const_world().particles.live()) + " / "
+			+ to_string(const_world().particles.capacity()); }
+		<< "\nRendered: " << [this](){ const auto& s = oon_main_view().render_stats; return to_string(s.drawn) + " drawn, "
+			+ to_string(s.lod) + " as points, " + to_string(s.culled) + " culled"; }
 		<< "\n"
 	;
 
@@ -378,14 +411,16 @@ void OONApp::ui_setup_HUD_ObjMonitor(/*!!, mode/config...!!*/)
 //cerr << "no_obj - hovered_entity_ndx: " << this->hovered_entity_ndx << "\n";
 //		return hovered_entity_ndx != ~0u ? hovered_entity_ndx >= entity_count()
 //		                                 : focused_entity_ndx >= entity_count();
-		return !( hovered_entity_ndx < entity_count() ||
-		          focused_entity_ndx < entity_count() );
+		return !( hovered_entity_ndx() < entity_count() ||
+		          focused_entity_ndx() < entity_count() );
 	};
-	static auto obj = [this]() -> const Entity& {
-		return entity(hovered_entity_ndx != ~0u ? hovered_entity_ndx : focused_entity_ndx);
+	static auto obj = [this]() -> Entity { //! Fetched anew for every use, so it can't go stale.
+		//! A copy: the (non-const) EntityRef would mark the body as Changed (in
+		//! every frame), and from the render thread, too (see OONConfig::render_thread)!
+		return const_entity(hovered_entity_ndx() != ~0u ? hovered_entity_ndx() : focused_entity_ndx());
 	};
 	static auto id = [this]() -> size_t {
-		return hovered_entity_ndx != ~0u ? hovered_entity_ndx : focused_entity_ndx;
+		return hovered_entity_ndx() != ~0u ? hovered_entity_ndx() : focused_entity_ndx();
 	};
 
 	ui_gebi(ObjMonitor)
@@ -31,6 +31,7 @@
 
 #include <thread>
 #include <mutex>
+#include <chrono>
 #include <memory>
 	using std::make_shared;
 #include <cstdlib>
@@ -52,6 +53,7 @@ using namespace std;
 //============================================================================
 namespace sync {
 	std::mutex Updating; //!!?? Updating what, when, by whom?
+	std::mutex Window;   // Held by render_thread_main_loop() for a whole frame, and while recreating the window
 };
 
 
@@ -123,6 +125,14 @@ void OONApp_sfml::update_thread_main_loop()
 #ifndef DISABLE_THREADS
 	std::unique_lock proc_lock{sync::Updating, std::defer_lock};
 
+	// Leave the drawing to another thread, if requested (see render_thread_main_loop()):
+	std::thread rendering;
+	if (appcfg.render_thread && !cfg.headless) {
+		_separate_rendering = true;
+		rendering = std::thread(&OONApp_sfml::render_thread_main_loop, this);
+	}
+	auto next_update = std::chrono::steady_clock::now(); // For pacing the updates, if not drawing here
+
 	while (!terminated()) {
 #endif
 		switch (ui_event_state) {
@@ -146,7 +156,7 @@ cerr << "- Oops! proc_lock.lock() failed! (already locked? " << proc_lock.owns_l
 			poll_controls(); // Should follow update_keys_from_SFML() (or else they'd get out of sync by some thread-switching delay!), until that's ensured implicitly!
 			updates_for_next_frame();
 
-			if (!cfg.headless) {
+			if (!cfg.headless && !_separate_rendering) {
 				//!!?? Why is this redundant?!
 				if (!SFML_WINDOW().setActive(true)) { //https://stackoverflow.com/a/23921645/1479945
 					cerr << "\n- [update_thread_main_loop] sf::setActive(true) failed!\n";
@@ -178,6 +188,23 @@ cerr << "- Oops! proc_lock.lock() failed! (already locked? " << proc_lock.owns_l
 			catch (...) {
 cerr << "- WTF: proc_lock.unlock() failed?! (already unlocked? " << !proc_lock.owns_lock() << ")\n";
 			}
+			// There's no display() here then to pace the updates (to the FPS limit),
+			// so sleep to the frame budget instead, or else the loop would just spin
+			// (and the frame delay-based stuff, like avg_frame_delay, would go nuts):
+			if (_separate_rendering) {
+				float budget = backend.hci.get_frame_rate_limit() ? 1.f / backend.hci.get_frame_rate_limit()
+				             : cfg.fixed_model_dt_enabled ? cfg.fixed_model_dt
+				             : 0; // No limit: as fast as it can (as with drawing here without a limit)
+				if (budget > 0) {
+					using namespace std::chrono;
+					next_update += duration_cast<steady_clock::duration>(duration<float>(budget));
+					if (auto now = steady_clock::now(); next_update < now)
+						next_update = now; // Don't try to catch up after a stall (or a pause)
+					std::this_thread::sleep_until(next_update);
+				} else {
+					std::this_thread::yield(); // Let the renderer (or the events) have the lock, too
+				}
+			}
 #endif
 			break;
 		default:
@@ -208,12 +235,67 @@ cerr << "- WTF: proc_lock.unlock() failed?! (already unlocked? " << !proc_lock.o
 //cerr << "sf::Context [update loop]: " << sf::Context::getActiveContextId() << endl;
 #ifndef DISABLE_THREADS
 	}
+
+	if (rendering.joinable()) rendering.join();
 #endif
 }
 
+//----------------------------------------------------------------------------
+void OONApp_sfml::render_thread_main_loop()
+// Draws the latest render snapshot of the model over and over (see
+// OONMainDisplay::publish_snapshot()), at whatever frame rate the window
+// allows (i.e. the FPS limit and/or vsync), while the model updates go on
+// at their own rate in the update thread, not waiting for display() at all.
+//
+// The scene is drawn from the render snapshot alone, so the updates can go
+// on meanwhile; sync::Updating is only held for the GUI and the HUDs (see
+// draw_overlays()), which still read the live app state.
+// The window itself is held (sync::Window) for the whole frame, so it can't
+// be recreated (e.g. by toggling fullscreen) while drawing.
+//
+//! Lock order: sync::Window, then sync::Updating (see the F11 handler in the
+//! event loop, too).
+//!! The FPS gauge shows the (paced) update rate, not the frame rate.
+{
+	while (!terminated()) {
+		std::unique_lock window_lock{sync::Window};
+
+		if (!SFML_WINDOW().setActive(true)) { //https://stackoverflow.com/a/23921645/1479945
+			cerr << "\n- [render_thread_main_loop] sf::setActive(true) failed!\n";
+		}
+
+		draw_scene();
+		{
+			std::lock_guard overlay_lock{sync::Updating};
+			draw_overlays();
+		}
+
+		SFML_WINDOW().display(); // The FPS limit (if any) sleeps in here
+
+		if (!SFML_WINDOW().setActive(false)) {
+			cerr << "\n- [render_thread_main_loop] sf::setActive(false) failed!\n";
+		}
+		window_lock.unlock();
+
+		// Drop the frame rate if paused (like the update loop)
+		if (paused()) {
+			sf::sleep(sf::milliseconds(
+				cfg.get("sim/timing/paused_sleep_time_per_cycle", 40) // #330
+			));
+		}
+	}
+}
+
 //----------------------------------------------------------------------------
 void OONApp_sfml::draw() // override
 //!!?? Is there a nice, exact criteria by which UI rendering can be distinguished from model rendering?
+{
+	draw_scene();
+	draw_overlays();
+	SFML_WINDOW().display();
+}
+
+void OONApp_sfml::draw_scene()
 {
 //#ifdef DEBUG
 	if (!controls.ShowOrbits) // -> #225
@@ -221,7 +303,12 @@ void OONApp_sfml::draw() // override
 		SFML_WINDOW().clear();
 
 	oon_main_view().draw(); //!! Change it to draw(surface)!
+		//! Only from the latest render snapshot, so the model may be updating meanwhile.
+}
 
+void OONApp_sfml::draw_overlays()
+// These still read the live app state, so not while it's being updated!
+{
 /*cerr << std::boolalpha
 	<< "wallpap? "<<gui.hasWallpaper() << ", "
 	<< "clea bg? "<<sfw::Theme::clearBackground << ", "
@@ -242,8 +329,6 @@ void OONApp_sfml::draw() // override
 		                                      //!! "Activity" means more than just drawing, so... (Or actually both should control it?)
 	}
 #endif
-
-	SFML_WINDOW().display();
 }
 
 
@@ -396,11 +481,11 @@ try {
 						//!! off view confinement, but it can't be done yet. :-/
 					} else {
  						// Select the player obj. by default (or with a dedicated modifier); same as with MouseButton!
- 						if (/*keystate(ALT) || */focused_entity_ndx == ~0u)
-							focused_entity_ndx = player_entity_ndx();
+ 						if (/*keystate(ALT) || */focused_entity_ndx() == ~0u)
+							focus_entity(player_entity_ndx());
 
-						assert(focused_entity_ndx != ~0u);
-						pan_to_center(focused_entity_ndx);
+						assert(focused_entity_ndx() != ~0u);
+						pan_to_center(focused_entity_ndx());
 					}
 					break;
 
@@ -412,11 +497,18 @@ try {
 				case SFML_KEY(F12): toggle_huds();
 					sfw::set<sfw::CheckBox>("Show HUDs", huds_active());
 					break;
-				case SFML_KEY(F11):
+				case SFML_KEY(F11): {
+					// Not while the render thread (if any) is drawing to the old window
+					// (but sync::Window must be taken first; see render_thread_main_loop()):
+					bool relock = noproc_lock.owns_lock();
+					if (relock) noproc_lock.unlock();
+					std::lock_guard window_lock{sync::Window};
+					if (relock) noproc_lock.lock();
 					toggle_fullscreen();
 					//!! Refresh all our own (app-level) dimensions, too!
 					//!! E.g. #288, and wrong .view size etc.!...
 					break;
+				}
 
 				default:
 //cerr << "UNHANDLED KEYPRESS: " << event.key.code << endl;
@@ -507,10 +599,10 @@ cerr << "DBG> Click: no obj.\n";
 
 				// Select the clicked object, if any (unless holding CTRL!)
 				/*if (!keystate(CTRL))*/ //!! Really should be ALT, but... that's the stupid shield. :)
-					focused_entity_ndx = clicked_entity_id == ~0u
+					focus_entity(clicked_entity_id == ~0u
 					                     ? (/*keystate(ALT) ? player_entity_ndx() // Select the player with a dedicated modifier; same as with Home!
-				                                                : */(keystate(SHIFT) ? focused_entity_ndx : ~0u))
-				                             : clicked_entity_id; // ~0u if none... //!!... Whoa! :-o See updates_for_next_frame()!
+				                                                : */(keystate(SHIFT) ? focused_entity_ndx() : ~0u))
+				                             : clicked_entity_id); // ~0u if none... //!!... Whoa! :-o See updates_for_next_frame()!
 /*!!
 				// Pan the selected object to focus, if holding SHIFT
 				//!!?? -- WHAT? There should be no panning whatsoever on a simple click!
@@ -518,13 +610,13 @@ cerr << "DBG> Click: no obj.\n";
  					// Select the player by default; same as with Home!
  					// (Unless, as above, holding CTRL!)
 					if (//!keystate(CTRL) &&
-					    focused_entity_ndx == ~0u)
-						focused_entity_ndx = player_entity_ndx();
+					    focused_entity_ndx() == ~0u)
+						focus_entity(player_entity_ndx());
 //!!?? -- SHIFT should just have the usual effect of locking the scroll!
-					pan_to_focus(focused_entity_ndx); //! Tolerates ~0u!
+					pan_to_focus(focused_entity_ndx()); //! Tolerates ~0u!
 				}
 !!*/
-				if (focused_entity_ndx == ~0u)
+				if (focused_entity_ndx() == ~0u)
 					cerr << "- Nothing there. Focusing on the deep void...\n"; //!! Do something better than this... :)
 				break;
 			}
@@ -546,10 +638,10 @@ cerr << "DBG> Click: no obj.\n";
 				size_t entity_id = ~0u;
 				if (entity_at_viewpos(vpos.x, vpos.y, &entity_id)) {
 //cerr << "- Following object #"<<clicked_entity_id<<" now...\n";
-					hovered_entity_ndx = entity_id;
+					hover_entity(entity_id);
 				} else {
 //cerr << "DBG> Click: no obj.\n";
-					hovered_entity_ndx = ~0u;
+					hover_entity(~0u);
 				}
 				break;
 			}
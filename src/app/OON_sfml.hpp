@@ -41,7 +41,10 @@ protected:
 	//!! DeSFMLize parts most of these & move to OONApp:
 	void event_loop() override; // Uses the SFML Event stuff + sf::Window
 	void update_thread_main_loop() override; // Uses sf::Window, sf::sleep
+	void render_thread_main_loop(); // Uses sf::Window, sf::sleep (see OONConfig::render_thread)
 	void draw() override; // Uses sf::Window
+	void draw_scene();    // From the render snapshot only (see render_thread_main_loop())
+	void draw_overlays(); // GUI, HUDs: needs sync::Updating, if not called between the updates
 
 //------------------------------------------------------------------------
 // C++ mechanics...
@@ -53,6 +56,7 @@ public:
 // Data / Internals...
 //------------------------------------------------------------------------
 protected:
+	bool _separate_rendering = false; // draw() is called by render_thread_main_loop(), not between the updates
 
 #ifndef DISABLE_HUDS
 //!!	UI::HUD& ...;
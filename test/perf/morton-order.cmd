@@ -0,0 +1,47 @@
+@echo off
+call %~dp0..\..\tooling\_setenv.cmd
+
+:: Benchmark for the Morton reordering of the bodies (--reorder): the same
+:: random worlds with the Barnes-Hut solver and the broadphase (the ones that
+:: suffer the most from the lost locality), without and with the reordering.
+::
+:: The random bodies start out in random index order, so the difference is
+:: there right from the start. (For the cache misses themselves, run it in a
+:: profiler, e.g. VTune's Memory Access analysis.)
+
+:: Empty means use the latest, otherwise SZ_RUN_DIR/%1:
+set oon_use_exe=%1
+
+call :bench 20000  50
+call :bench 100000 10
+goto :eof
+
+
+:bench
+echo -------------------------------------------------------------------
+echo %1 bodies, %2 cycles, unsorted...
+echo -------------------------------------------------------------------
+call :run %1 %2
+echo -------------------------------------------------------------------
+echo %1 bodies, %2 cycles, reordered every 10 ticks...
+echo -------------------------------------------------------------------
+call :run %1 %2 --reorder=10
+goto :eof
+
+
+:run
+%SZ_PRJDIR%/tooling/diag/wtime %SZ_PRJDIR%/run-latest ^
+--headless ^
+--cfg=test/default.cfg --snd=off ^
+--interact ^
+--bodies=%1 ^
+--barnes-hut ^
+--broadphase ^
+--fixed-dt=0.033 ^
+--fps-limit=0 ^
+--loop-cap=%2 ^
+--exit-on-finish ^
+--no-session-autosave ^
+%3 ^
+
+goto :eof
@@ -0,0 +1,44 @@
+@echo off
+call %~dp0..\..\tooling\_setenv.cmd
+
+:: Microbenchmark for the exact (scalar) pairwise interaction loop:
+:: random worlds of 500, 2000 and 10000 bodies, headless, with all the other
+:: solvers off (the default cfg), timed with wtime.
+::
+:: To see the gain of a change, run it with both the old and the new build
+:: (copied to SZ_RUN_DIR), and compare the times, e.g.:
+::
+::    pairwise-loop oon-old
+::    pairwise-loop
+::
+:: The cycles are scaled down with n*n, so each case should take about the
+:: same time.
+::
+:: Extra options for all the runs can be passed in bench_opts (e.g. --simd).
+
+:: Empty means use the latest, otherwise SZ_RUN_DIR/%1:
+set oon_use_exe=%1
+
+call :bench 500   400
+call :bench 2000  25
+call :bench 10000 1
+goto :eof
+
+
+:bench
+echo -------------------------------------------------------------------
+echo %1 bodies, %2 cycles...
+echo -------------------------------------------------------------------
+%SZ_PRJDIR%/tooling/diag/wtime %SZ_PRJDIR%/run-latest ^
+--headless ^
+--cfg=test/default.cfg --snd=off ^
+--interact ^
+--bodies=%1 ^
+--fixed-dt=0.033 ^
+--fps-limit=0 ^
+--loop-cap=%2 ^
+--exit-on-finish ^
+--no-session-autosave ^
+%bench_opts% ^
+
+goto :eof
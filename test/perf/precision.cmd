@@ -0,0 +1,44 @@
+@echo off
+call %~dp0..\..\tooling\_setenv.cmd
+
+:: Side-by-side benchmark of the float, double and mixed precision builds of
+:: the model, with the same worlds as pairwise-loop.cmd.
+::
+:: Build both first (the double one with PRECISION=double, which gets an
+:: oon-double exe), and copy them to SZ_RUN_DIR, then e.g.:
+::
+::    precision oon oon-double
+::
+:: "Mixed" is the double build with the SIMD kernel (--simd), which runs on
+:: float copies of the positions (see World::_kernel_bodies()).
+
+setlocal
+set float_exe=%1
+if "%float_exe%" == "" set float_exe=oon
+set double_exe=%2
+if "%double_exe%" == "" set double_exe=oon-double
+
+echo ===================================================================
+echo float (%float_exe%):
+echo ===================================================================
+set bench_opts=
+call %~dp0pairwise-loop.cmd %float_exe%
+
+echo ===================================================================
+echo float + SIMD (%float_exe% --simd):
+echo ===================================================================
+set bench_opts=--simd
+call %~dp0pairwise-loop.cmd %float_exe%
+
+echo ===================================================================
+echo double (%double_exe%):
+echo ===================================================================
+set bench_opts=
+call %~dp0pairwise-loop.cmd %double_exe%
+
+echo ===================================================================
+echo mixed (%double_exe% --simd):
+echo ===================================================================
+set bench_opts=--simd
+call %~dp0pairwise-loop.cmd %double_exe%
+endlocal
@@ -0,0 +1,40 @@
+@echo off
+call %~dp0..\..\tooling\_setenv.cmd
+
+:: Accuracy report of the FMM gravity solver (--fmm), against the direct sum,
+:: on the start states of the regression tests, for a few expansion orders:
+::
+::    fmm-accuracy [exe] [more options...]
+::
+:: Not a pass/fail test: it just prints the max. relative error, and the RMS
+:: error relative to the RMS force, for the first tick of each run (filtered
+:: from the rest of the log), or complains if there was no such report (i.e.
+:: the FMM didn't run at all).
+:: (Only the Hyperbolic gravity mode has an FMM; see src/Model/FMM.hpp. The
+:: start states are in that mode, with all the bodies interacting.)
+
+set regdir=%~dp0
+set baseline_version=2024-09-18
+set "baseline_dir=%regdir%_baseline-%baseline_version%"
+
+:: Empty means use the latest, otherwise SZ_RUN_DIR/%1:
+set oon_use_exe=%1
+
+for %%s in (500_bodies 1000_bodies) do (
+	for %%o in (4 8 12 20) do (
+		echo %%s, order %%o:
+		%SZ_PRJDIR%/run-latest ^
+		--headless ^
+		--cfg=test/default.cfg --snd=off ^
+		--interact ^
+		--fixed-dt=0.033 ^
+		--fps-limit=0 ^
+		--loop-cap=1 ^
+		--exit-on-finish ^
+		--session=%baseline_dir%/%%s-START.state ^
+		--no-session-autosave ^
+		--fmm=%%o --fmm-check ^
+		%2 %3 %4 %5 %6 %7 %8 %9 ^
+		2>&1 | findstr /b /c:"FMM (order" || echo !!! NO FMM REPORT: THE FMM DIDN'T RUN !!!
+	)
+)
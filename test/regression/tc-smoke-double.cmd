@@ -0,0 +1,62 @@
+@echo off
+call %~dp0..\..\tooling\_setenv.cmd
+
+:: Same as tc-smoke, but for the double build of the model (PRECISION=double),
+:: and for the mixed mode, too, with the SIMD kernel (float accelerations) on:
+::
+::    tc-smoke-double [exe] [--simd]
+::
+:: (The exe defaults to oon-double.)
+::
+:: It starts from the same (float) START state as tc-smoke (the double build
+:: can load the float saves), and its END state is checked against the float
+:: reference of tc-smoke, too: not bit-exact (that can't be), but within
+:: --compare-tolerance (relative to the RMS of the reference positions and
+:: velocities; see OONApp::compare_with_reference()). (--simd is kept by the
+:: --session load, so the mixed mode does run the SIMD kernel.)
+
+set regdir=%~dp0
+
+set baseline_version=2024-09-18
+
+set "baseline_dir=%regdir%_baseline-%baseline_version%"
+set "reference_startstate=%baseline_dir%/1000_bodies-START.state"
+set "reference_endstate=%regdir%tc-smoke\REFERENCE-END.state"
+set "new_endstate=%regdir%\END.state.tmp"
+
+::NOTES:
+:: * Override any option on the cmdline, as needed (by repeating)!
+:: * We must set --cfg in this setup, as it't not ./default.cfg
+:: * --loop-cap=0 means no cycle limit
+
+
+::set bodies=500
+set loop=20
+
+:: Empty means use the latest, otherwise SZ_RUN_DIR/%1:
+set oon_use_exe=%1
+if "%oon_use_exe%" == "" set oon_use_exe=oon-double
+
+%SZ_PRJDIR%/tooling/diag/wtime %SZ_PRJDIR%/run-latest ^
+--headless ^
+--cfg=test/default.cfg --snd=off ^
+--interact ^
+--friction=0.01 ^
+--zoom-adjust=0.2 ^
+--fixed-dt=0.033 ^
+--fps-limit=0 ^
+--loop-cap=%loop% ^
+--exit-on-finish ^
+--session=%reference_startstate% ^
+--session-save-as=%new_endstate% ^
+--no-save-compressed ^
+--compare-with=%reference_endstate% ^
+--compare-tolerance=1e-3 ^
+%2 ^
+
+
+if errorlevel 1 (
+	echo !!! THE RESULTS DIFFER !!! :-(
+) else (
+	echo OK. ^(Within tolerance of the float reference.^)
+)